@@ -35,12 +35,15 @@ mkdir ("./ooberrt/sample/employee");
 &copyRtSrcFiles ("rtbersrc");
 &copyRtSrcFiles ("rtxsrc");
 `cp ./rtbersrc/asn1ber.h ./ooberrt/rtbersrc`;
+`cp ./rtbersrc/asn1berPipeline.h ./ooberrt/rtbersrc`;
 `cp ./rtsrc/rtBCD.h ./ooberrt/rtsrc`;
 `cp ./rtsrc/rtPrint.h ./ooberrt/rtsrc`;
 `cp ./rtxsrc/rtxCharStr.h ./ooberrt/rtxsrc`;
 `cp ./rtxsrc/rtxCommon.h ./ooberrt/rtxsrc`;
 `cp ./rtxsrc/rtxEnum.h ./ooberrt/rtxsrc`;
+`cp ./rtxsrc/rtxOIDTable.h ./ooberrt/rtxsrc`;
 `cp ./rtxsrc/rtxPrint.h ./ooberrt/rtxsrc`;
+`cp ./rtxsrc/rtxThread.h ./ooberrt/rtxsrc`;
 `cp ./rtxsrc/systypes.h ./ooberrt/rtxsrc`;
 `cp ./build/makefile ./ooberrt/build`;
 `cp ./sample/employee/* ./ooberrt/sample/employee`;
@@ -24,6 +24,7 @@
 #define _ASN1BER_H_
 
 #include "rtxsrc/rtxCommon.h"
+#include "rtxsrc/rtxOIDTable.h"
 
 #define ASN1TAG_LSHIFT  24
 
@@ -70,6 +71,10 @@ typedef enum { ASN1IMPL, ASN1EXPL } ASN1TagType;
 #define XM_SKIP         0x08    /* skip to next field after parsing tag */
 #define XM_OPTIONAL     0x10    /* tag test is for optional element     */
 
+/* xd_Validate flags */
+
+#define XV_DER          0x01    /* check DER rules in addition to BER   */
+
 /* universal built-in type ID code value constants */
 
 #define ASN_ID_EOC      0       /* end of contents              */
@@ -135,6 +140,73 @@ typedef struct {                /* context control block        */
    int          stat;           /* status, returned by BS_CHKEND */
 } ASN1CCB;
 
+/* Tag dispatch table used by xd_TagDispatch to resolve the tag of an    */
+/* incoming SET or CHOICE element to a component index.  Single-octet     */
+/* tags are resolved by direct lookup on the identifier octet; tags with  */
+/* ID codes >= 31 are searched for in the registered tag array.           */
+
+typedef struct {
+   OSINT16        index1[256];  /* component index by identifier octet */
+   const ASN1TAG* pTags;        /* registered tags                     */
+   OSUINT32       numTags;      /* number of registered tags           */
+} ASN1TagDispatch;
+
+/* One step of a compiled element path.  The step selects the index'th  */
+/* element with the given tag (form bit ignored) among the elements at  */
+/* the current level.  A tag of 0 matches any element.                  */
+
+typedef struct {
+   ASN1TAG      tag;            /* tag to match or 0 for any tag        */
+   OSUINT32     index;          /* occurrence of tag (0 = first)        */
+} ASN1PathStep;
+
+/* Element located by xd_FindPath */
+
+typedef struct {
+   ASN1TAG        tag;          /* tag of element, including form bit   */
+   const OSOCTET* data;         /* contents octets in decode buffer     */
+   size_t         numocts;      /* number of contents octets, not
+                                   including any end-of-contents octets */
+} ASN1ElemSpan;
+
+/* Element decode function used by xd_SeqOfElems.  The signature is that  */
+/* of a generated BER type decode function with a void pointer in place   */
+/* of the typed value pointer.                                            */
+
+typedef int (*XD_ELEMDECFUNC)
+(OSCTXT* pctxt, void* pvalue, ASN1TagType tagging, int length);
+
+/* Start offsets of the elements of a SEQUENCE OF or SET OF value, as    */
+/* recorded by xd_ElemOffsets.  Short lists are held in the structure    */
+/* itself; longer ones in memory allocated from the context.           */
+
+#ifndef XD_K_LOCALOFFSETS
+#define XD_K_LOCALOFFSETS 32
+#endif
+
+typedef struct {
+   size_t*      pOffsets;       /* buffer offset of each element        */
+   size_t       count;          /* number of elements                   */
+   size_t       capacity;       /* number of entries in pOffsets        */
+   size_t       endIndex;       /* buffer offset of end of contents     */
+   size_t       local[XD_K_LOCALOFFSETS];
+} ASN1ElemOffsets;
+
+/* Registry of open type decode functions keyed by object identifier.   */
+/* OIDs are interned in the registry's OID table; the handle of an OID   */
+/* indexes its entry in the handler array.                               */
+
+typedef struct {
+   XD_ELEMDECFUNC decFunc;      /* decode function for the open type    */
+   size_t         valueSize;    /* size of decoded value                */
+} ASN1OIDHandler;
+
+typedef struct {
+   OSRTOIDTable   oidTable;     /* registered OIDs                      */
+   ASN1OIDHandler* handlers;    /* handler for handle h is handlers[h-1] */
+   OSUINT32       capacity;     /* allocated number of handlers         */
+} ASN1OIDRegistry;
+
 #ifdef __cplusplus
 extern "C" {
 
@@ -212,6 +284,54 @@ EXTERNRT int xd_tag (OSCTXT* pctxt, ASN1TAG *tag_p);
 EXTERNRT int xd_tag_len
 (OSCTXT *pctxt, ASN1TAG *tag_p, int *len_p, OSOCTET flags);
 
+/**
+ * This function initializes a tag dispatch table from the set of tags
+ * expected for the components of a SET or CHOICE type. The index of a tag
+ * in the given array is the component index returned by xd_TagDispatch.
+ * The form bit of the tags is ignored. The tag array is referenced, not
+ * copied, and must remain valid for the lifetime of the table; typically
+ * both are static data initialized once.
+ *
+ * @param pDisp        Pointer to dispatch table to initialize.
+ * @param pTags        Array of component tags.
+ * @param numTags      Number of tags in the array. At most
+ *                       ASN1_K_MaxSetElements tags may be registered.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - RTERR_INVPARAM if a tag is registered twice,
+ *                       - other negative return value is error.
+ */
+EXTERNRT int xd_TagDispatchInit
+(ASN1TagDispatch* pDisp, const ASN1TAG* pTags, OSUINT32 numTags);
+
+/**
+ * This function parses the tag and length at the current message pointer
+ * position and resolves the tag to a component index using the given
+ * dispatch table. This takes the place of a sequence of xd_match calls
+ * with XM_SEEK when decoding SET or CHOICE components.
+ *
+ * If a control block is given, the bit for the component in its set mask
+ * is tested and set; a component occurring twice is reported as
+ * RTERR_SETDUPL.
+ *
+ * If the tag is not in the table, the decode pointer is restored to the
+ * start of the tag and RTERR_IDNOTFOU is returned without logging an
+ * error, so the caller can skip the element as an extension or report it.
+ *
+ * @param pctxt       Pointer to context block structure.
+ * @param pDisp        Pointer to dispatch table.
+ * @param ccb_p        Pointer to context control block for duplicate
+ *                       checking or NULL if no check is to be done.
+ * @param pindex       Pointer to variable to receive the component index.
+ * @param len_p        Pointer to variable to receive the component length.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_TagDispatch
+(OSCTXT* pctxt, const ASN1TagDispatch* pDisp, ASN1CCB* ccb_p,
+ int* pindex, int* len_p);
+
 /**
  * This function compares the tag at the current message pointer position with
  * the given tag for a match. If a match occurs, the length field is decoded
@@ -239,6 +359,26 @@ EXTERNRT int xd_tag_len
 EXTERNRT int xd_match
 (OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags);
 
+/**
+ * This function tests for an element with the given tag in the same way as
+ * xd_match, but is intended for probing for optional elements. If the tag
+ * is not found, the decode pointer is restored and RTERR_IDNOTFOU is
+ * returned without logging it or changing the error information in the
+ * context, so nothing needs to be reset by the caller.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param tag          Tag variable to match.
+ * @param len_p        Length of message component, returned as described
+ *                       for xd_match.
+ * @param flags        Bit flags as described for xd_match.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - RTERR_IDNOTFOU = tag not found,
+ *                       - other negative return value is error.
+ */
+EXTERNRT int xd_probe
+(OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags);
+
 /**
  * This function parses an ASN.1 BOOLEAN tag/length/value at the current
  * message pointer location and advances the pointer to the next field.
@@ -481,6 +621,32 @@ EXTERNRT int xd_uint64 (OSCTXT *pctxt, OSUINT64 *object_p,
 EXTERNRT int xd_bigint
 (OSCTXT *pctxt, const char** pvalue, ASN1TagType tagging, int length);
 
+/**
+ * This function decodes a variable of the ASN.1 INTEGER type into a big
+ * integer in binary sign-magnitude form. Unlike xd_bigint, no character
+ * string conversion is done; the value can be converted to text when it
+ * is printed using rtxPrintBigInt.
+ *
+ * For a non-negative value the sign octet and any other leading zero
+ * octets are stripped. If the ASN1FASTCOPY context flag is set, the
+ * magnitude then references the decode buffer directly; otherwise it is
+ * copied to memory allocated using rtxMemAlloc. The magnitude of a
+ * negative value is always computed into allocated memory.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param pvalue       Pointer to big integer structure to receive the
+ *                       decoded value.
+ * @param tagging      Specifies whether element is implicitly or explicitly
+ *                       tagged.
+ * @param length       Length of data to retrieve. Valid for implicit case
+ *                       only.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_binbigint
+(OSCTXT *pctxt, ASN1BigInt* pvalue, ASN1TagType tagging, int length);
+
 /**
  * This function decodes a variable of the ASN.1 BIT STRING type into a static
  * memory structure. This function call is generated by ASN1C to decode a sized
@@ -588,6 +754,8 @@ EXTERNRT int xd_octstr
  * This function is the base function for decoding any of the 8-bit character
  * string useful types such as IA5String, VisibleString, etc. This function
  * allocates memory for the decoded string and returns a pointer to the data.
+ * If the ASN1STRICTSTR context flag is set, the characters are checked
+ * against the string type given by the tag as described for rtValidateStr.
  *
  * @param pctxt       Pointer to ASN.1 context block structure
  * @param pvalue     Pointer to a pointer to receive the address of the
@@ -684,6 +852,48 @@ EXTERNRT int xd_32BitCharStr
 (OSCTXT* pctxt, Asn132BitCharString* pvalue,
  ASN1TagType tagging, ASN1TAG tag, int length);
 
+/**
+ * This function decodes a 16-bit character string such as BMPString
+ * directly to a UTF-8 string, without an intermediate array of 16-bit
+ * characters. This function allocates memory for the decoded string.
+ *
+ * @param pctxt        Pointer to ASN.1 context block structure
+ * @param ppvalue      Pointer to a pointer to receive the address of the
+ *                       allocated null-terminated UTF-8 string.
+ * @param tagging      Specifies whether element is implicitly or explicitly
+ *                       tagged.
+ * @param tag          Tag variable to match.
+ * @param length       Length of data to retrieve. Valid for implicit case
+ *                       only.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_16BitCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR** ppvalue,
+ ASN1TagType tagging, ASN1TAG tag, int length);
+
+/**
+ * This function decodes a 32-bit character string such as UniversalString
+ * directly to a UTF-8 string, without an intermediate array of 32-bit
+ * characters. This function allocates memory for the decoded string.
+ *
+ * @param pctxt        Pointer to ASN.1 context block structure
+ * @param ppvalue      Pointer to a pointer to receive the address of the
+ *                       allocated null-terminated UTF-8 string.
+ * @param tagging      Specifies whether element is implicitly or explicitly
+ *                       tagged.
+ * @param tag          Tag variable to match.
+ * @param length       Length of data to retrieve. Valid for implicit case
+ *                       only.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_32BitCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR** ppvalue,
+ ASN1TagType tagging, ASN1TAG tag, int length);
+
 /**
  * This function decoded the ASN.1 NULL placeholder type. The null data type
  * contains no data; however, if explicit tagging is specified, it will contain
@@ -738,6 +948,29 @@ EXTERNRT int xd_objid
 int decodeRelOID
 (OSCTXT *pctxt, ASN1OBJID *pvalue, ASN1TagType tagging, int length);
 
+/**
+ * This function decodes a value of the ASN.1 object identifier type into
+ * compact encoded form. The contents octets are validated but not
+ * converted; the decoded value references them in the message buffer,
+ * which must remain valid while the value is in use.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param pvalue       Pointer to value to receive decoded result.
+ * @param pTable       Pointer to an OID table used to set the handle of the
+ *                       decoded value. If NULL or if the OID is not in the
+ *                       table, the handle is set to zero.
+ * @param tagging      Specifies whether element is implicitly or explicitly
+ *                       tagged.
+ * @param length       Length of data to retrieve. Valid for implicit case
+ *                       only.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_encobjid
+(OSCTXT *pctxt, ASN1EncOID *pvalue, const OSRTOIDTable* pTable,
+ ASN1TagType tagging, int length);
+
 /**
  * This function decodes a value of the ASN.1 ENUMERATED type. This function is
  * identical to the integer decode function (xd_integer) except that the
@@ -780,7 +1013,9 @@ EXTERNRT int xd_enumUInt16
  * model the old ASN.1 ANY and ANY DEFINED BY types. It is also used to model
  * variable type references within information objects (for example,
  * TYPE-IDENTIFER.&Type). Dynamic memory is allocated to hold the decoded
- * result.
+ * result, unless the ASN1FASTCOPY flag is set in the context. In that case,
+ * the result references the encoded value in the message buffer, which must
+ * then remain valid while the result is in use.
  *
  * @param pctxt       Pointer to context block structure.
  * @param pvalue2    Pointer to value to receive decoded result.
@@ -793,10 +1028,118 @@ EXTERNRT int xd_enumUInt16
 EXTERNRT int xd_OpenType
 (OSCTXT *pctxt, const OSOCTET** pvalue2, OSUINT32* numocts_p);
 
+/**
+ * This function decodes unknown extension elements in a SEQUENCE, SET or
+ * CHOICE. Elements are collected as open types until an element with one of
+ * the given tags is found or, if no tags are given, until the end of the
+ * enclosing constructed value is reached.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param ccb_p        Pointer to context control block of the enclosing
+ *                       constructed value.
+ * @param tags         Tags of the elements that end the extension, or NULL.
+ * @param tagCount     Number of tags in the tags array.
+ * @param pElemList    List to receive the unknown elements as ASN1OpenType
+ *                       values. If NULL, the elements are skipped without
+ *                       being copied.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
 EXTERNRT int xd_OpenTypeExt
 (OSCTXT* pctxt, ASN1CCB* ccb_p, ASN1TAG* tags, int tagCount,
  OSRTDList *pElemList);
 
+/**
+ * This function initializes an OID handler registry. Memory used by the
+ * registry is allocated from the given context.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param pReg         Pointer to registry to initialize.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int berOIDRegInit (OSCTXT* pctxt, ASN1OIDRegistry* pReg);
+
+/**
+ * This function frees all memory held by an OID handler registry.
+ *
+ * @param pReg         Pointer to registry.
+ */
+EXTERNRT void berOIDRegFree (ASN1OIDRegistry* pReg);
+
+/**
+ * This function registers the decode function for open type values
+ * identified by the given OID. A handler registered earlier for the same
+ * OID is replaced.
+ *
+ * @param pReg         Pointer to registry.
+ * @param data         Contents octets of the encoded OID.
+ * @param numocts      Number of contents octets.
+ * @param decFunc      Function used to decode the open type value. It is
+ *                       called with explicit tagging.
+ * @param valueSize    Size of the decoded value structure. It must be
+ *                       nonzero; RTERR_INVPARAM is returned otherwise.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int berOIDRegAdd
+(ASN1OIDRegistry* pReg, const OSOCTET* data, OSUINT32 numocts,
+ XD_ELEMDECFUNC decFunc, size_t valueSize);
+
+/**
+ * This function registers a decode function as described for berOIDRegAdd
+ * for an OID given as a list of subidentifiers.
+ *
+ * @param pReg         Pointer to registry.
+ * @param pOID         Pointer to OID value.
+ * @param decFunc      Function used to decode the open type value.
+ * @param valueSize    Size of the decoded value structure; must be
+ *                       nonzero.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int berOIDRegAddObjId
+(ASN1OIDRegistry* pReg, const ASN1OBJID* pOID,
+ XD_ELEMDECFUNC decFunc, size_t valueSize);
+
+/**
+ * This function returns the handler registered for the given OID. If the
+ * OID has a nonzero handle, it must have been decoded using the OID table
+ * of this registry; otherwise, its contents octets are looked up.
+ *
+ * @param pReg         Pointer to registry.
+ * @param pOID         Pointer to OID in encoded form.
+ * @return             Pointer to handler or NULL if none is registered.
+ */
+EXTERNRT const ASN1OIDHandler* berOIDRegFind
+(const ASN1OIDRegistry* pReg, const ASN1EncOID* pOID);
+
+/**
+ * This function decodes an open type value whose type is identified by the
+ * given OID (for example, an ANY DEFINED BY field). If a handler is
+ * registered for the OID, a zeroed value of the registered size is
+ * allocated and decoded with it. Otherwise, the value is returned in
+ * encoded form as done by xd_OpenType, or skipped if pOpenType is NULL.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param pReg         Pointer to registry.
+ * @param pOID         Pointer to the identifying OID in encoded form.
+ * @param ppvalue      Pointer to variable to receive the decoded value, or
+ *                       NULL if no handler is registered.
+ * @param pOpenType    Pointer to structure to receive the encoded value if
+ *                       no handler is registered. May be NULL.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_OpenTypeByOID
+(OSCTXT* pctxt, const ASN1OIDRegistry* pReg, const ASN1EncOID* pOID,
+ void** ppvalue, ASN1OpenType* pOpenType);
+
 /**
  * This function sets the decode pointer (cursor) to point at the beginning of
  * the encoded ASN.1 message that is to be decoded. This function must be
@@ -883,6 +1226,181 @@ EXTERNRT int xd_count (OSCTXT *pctxt, int length, int *count_p);
  */
 EXTERNRT int xd_NextElement (OSCTXT* pctxt);
 
+/**
+ * This function checks that the element at the current decode position is
+ * a well-formed BER encoding, or a valid DER encoding if the XV_DER flag
+ * is set. No memory is allocated and nested values are walked without
+ * recursion, so it is suitable for screening untrusted input before it is
+ * decoded. Identifier and length octets are checked as in xd_tag_len;
+ * universal types are also checked for the correct form and, for the
+ * simple primitive types, valid contents. In DER mode, minimal lengths,
+ * primitive strings and the tag order of SET components are also checked;
+ * components with equal tags are taken to be SET OF elements and must be
+ * in ascending order of their encodings.
+ *
+ * On success the decode position is moved past the element. On failure
+ * it is left at the start of the innermost element found to be invalid.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param flags        Validation flags: 0 for BER or XV_DER for DER.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_Validate (OSCTXT* pctxt, OSUINT32 flags);
+
+/**
+ * This function compiles a path expression into an array of path steps
+ * for use with xd_FindPath. An expression is a list of steps separated by
+ * '.'. Each step is a tag followed by an optional occurrence index in
+ * brackets. The tag can be given as:
+ *   - a bracketed tag, for example [0], [APPLICATION 3] or [PRIVATE 1]
+ *     (the default class is context-specific),
+ *   - a universal type name: BOOL, INT, BITSTR, OCTSTR, NULL, OID, REAL,
+ *     ENUM, UTF8, RELOID, SEQ, SET, NUMERIC, PRINTABLE, T61, IA5,
+ *     UTCTIME, GENTIME, VISIBLE, UNIVSTR or BMP,
+ *   - '*' to match any tag.
+ *
+ * For example, "SEQ.SEQ.INT" selects the serial number of an X.509
+ * certificate and "SEQ.SEQ.SEQ[2]" its subject name.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param expr         Path expression.
+ * @param pSteps       Array to receive the compiled steps.
+ * @param maxSteps     Number of elements in the steps array.
+ * @param pNumSteps    Pointer to variable to receive the number of steps.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - RTERR_INVFORMAT if the expression is invalid,
+ *                       - other negative return value is error.
+ */
+EXTERNRT int berPathCompile
+(OSCTXT* pctxt, const char* expr, ASN1PathStep* pSteps, OSUINT32 maxSteps,
+ OSUINT32* pNumSteps);
+
+/**
+ * This function locates an element in the decode buffer by following a
+ * compiled path. The first step selects among the elements starting at
+ * the current decode position, each following step among the elements in
+ * the contents of the element selected by the previous step. Elements not
+ * on the path are skipped without being decoded and no memory is
+ * allocated.
+ *
+ * On success, the contents octets of the element are returned as a
+ * reference into the decode buffer and the decode position is left at the
+ * start of the element, so a primitive value can be decoded by calling the
+ * xd_ function for its type with explicit tagging. On failure the decode
+ * position is unchanged.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param pSteps       Compiled path steps.
+ * @param numSteps     Number of path steps.
+ * @param pSpan        Pointer to variable to receive the element found.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - RTERR_IDNOTFOU if the path does not exist,
+ *                       - other negative return value is error.
+ */
+EXTERNRT int xd_FindPath
+(OSCTXT* pctxt, const ASN1PathStep* pSteps, OSUINT32 numSteps,
+ ASN1ElemSpan* pSpan);
+
+/**
+ * This function scans the elements of a SEQUENCE OF or SET OF type once,
+ * recording the start offset of each element, in the same way xd_count
+ * counts them. On entry the decode cursor must be positioned at the
+ * start of the contents; on return it is at the end of the contents,
+ * before the end-of-contents marker of an indefinite length type.
+ *
+ * @param pctxt       Pointer to context block structure.
+ * @param length       Length of the constructed type contents or
+ *                       ASN_K_INDEFLEN.
+ * @param pOffsets     Pointer to structure to receive the offsets. If the
+ *                       call succeeds, it must be released using
+ *                       xd_FreeElemOffsets.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_ElemOffsets
+(OSCTXT *pctxt, int length, ASN1ElemOffsets* pOffsets);
+
+/**
+ * This function releases the memory held by element offsets recorded by
+ * xd_ElemOffsets.
+ *
+ * @param pctxt        Pointer to the context block structure passed to
+ *                       xd_ElemOffsets.
+ * @param pOffsets     Pointer to element offsets structure.
+ */
+EXTERNRT void xd_FreeElemOffsets (OSCTXT *pctxt, ASN1ElemOffsets* pOffsets);
+
+/**
+ * This function decodes the elements of a SEQUENCE OF or SET OF type into
+ * a linked list. The start of each element is recorded in one scan using
+ * xd_ElemOffsets, all list nodes and element values are then allocated
+ * in one block using rtxDListAllocNodesAndData, and finally each element
+ * is decoded in place from its recorded start by calling the given
+ * element decode function with explicit tagging. An element that does
+ * not end where the scan found the next element to start is an error.
+ *
+ * On entry the decode cursor must be positioned at the start of the
+ * contents. The end-of-contents marker of an indefinite length
+ * constructed type is not consumed; this is left to the caller as in
+ * generated code.
+ *
+ * @param pctxt       Pointer to context block structure.
+ * @param pList        Pointer to list structure to receive the decoded
+ *                       elements. Nodes are appended to the list.
+ * @param elemSize     Size in bytes of a decoded element value.
+ * @param length       Length of the constructed type contents or
+ *                       ASN_K_INDEFLEN.
+ * @param decFunc      Element decode function.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - RTERR_BADVALUE if an element was not decoded
+ *                         up to the start of the next one,
+ *                       - other negative return value is error.
+ */
+EXTERNRT int xd_SeqOfElems
+(OSCTXT* pctxt, OSRTDList* pList, size_t elemSize, int length,
+ XD_ELEMDECFUNC decFunc);
+
+/**
+ * This function is a multi-threaded version of xd_SeqOfElems for large
+ * SEQUENCE OF or SET OF values. As in xd_SeqOfElems, a scan records the
+ * start of each element and all list nodes and element values are
+ * allocated in one block. The element range is then split into
+ * contiguous partitions that are decoded concurrently. Each thread
+ * decodes into its own context; the memory allocated by the element
+ * decode function is moved into the given context when all threads have
+ * finished, so the resulting list is in element order and is owned by
+ * the given context as if it had been decoded serially.
+ *
+ * The element decode function must only use the context passed to it.
+ * Small lists are decoded serially.
+ *
+ * If more than one partition fails, the error of the first failing
+ * partition is reported.
+ *
+ * @param pctxt       Pointer to context block structure.
+ * @param pList        Pointer to list structure to receive the decoded
+ *                       elements. Nodes are appended to the list.
+ * @param elemSize     Size in bytes of a decoded element value.
+ * @param length       Length of the constructed type contents or
+ *                       ASN_K_INDEFLEN.
+ * @param decFunc      Element decode function.
+ * @param numThreads   Number of threads to use, including the calling
+ *                       thread. If zero or negative, the number of
+ *                       available processors is used.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xd_SeqOfElemsParallel
+(OSCTXT* pctxt, OSRTDList* pList, size_t elemSize, int length,
+ XD_ELEMDECFUNC decFunc, int numThreads);
+
 /**
  * This function is an optimized version of the xd_tag_len function.
  * If the ASN1C compiler determines the tag at a given location to be parsed
@@ -1235,6 +1753,26 @@ EXTERNRT int xe_uint64 (OSCTXT* pctxt, OSUINT64 *object_p,
 EXTERNRT int xe_bigint
 (OSCTXT* pctxt, const char* pvalue, ASN1TagType tagging);
 
+/**
+ * This function encodes a big integer in binary sign-magnitude form as a
+ * variable of the ASN.1 INTEGER type. Leading zero octets of the magnitude
+ * are ignored and a sign octet is added where the two's complement
+ * encoding requires one.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param pvalue       Pointer to big integer value to be encoded.
+ * @param tagging      An enumerated type whose value is set to either
+ *                       'ASN1EXPL' (for explicit tagging) or 'ASN1IMPL' (for
+ *                       implicit). Controls whether the universal tag value
+ *                       for this type is added or not. Users will generally
+ *                       always set this value to 'ASN1EXPL'.
+ * @return             Length of the encoded message component. A negative
+ *                       status value will be returned if encoding is not
+ *                       successful.
+ */
+EXTERNRT int xe_binbigint
+(OSCTXT* pctxt, const ASN1BigInt* pvalue, ASN1TagType tagging);
+
 /**
  * This function will encode a variable of the ASN.1 BIT STRING type.
  *
@@ -1402,6 +1940,43 @@ EXTERNRT int xe_32BitCharStr
 (OSCTXT* pctxt, Asn132BitCharString* pvalue,
  ASN1TagType tagging, ASN1TAG tag);
 
+/**
+ * This function encodes a UTF-8 string as a 16-bit character string such
+ * as BMPString. Characters outside the Basic Multilingual Plane cannot be
+ * encoded.
+ *
+ * @param pctxt        Pointer to a context block structure.
+ * @param pvalue       Null-terminated UTF-8 string to be encoded.
+ * @param tagging      An enumerated type whose value is set to either
+ *                       'ASN1EXPL' (for explicit tagging) or 'ASN1IMPL' (for
+ *                       implicit).
+ * @param tag          The ASN.1 tag to be encoded in the message.
+ * @return             Length of the encoded message component. A negative
+ *                       status value will be returned if encoding is not
+ *                       successful.
+ */
+EXTERNRT int xe_16BitCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR* pvalue,
+ ASN1TagType tagging, ASN1TAG tag);
+
+/**
+ * This function encodes a UTF-8 string as a 32-bit character string such
+ * as UniversalString.
+ *
+ * @param pctxt        Pointer to a context block structure.
+ * @param pvalue       Null-terminated UTF-8 string to be encoded.
+ * @param tagging      An enumerated type whose value is set to either
+ *                       'ASN1EXPL' (for explicit tagging) or 'ASN1IMPL' (for
+ *                       implicit).
+ * @param tag          The ASN.1 tag to be encoded in the message.
+ * @return             Length of the encoded message component. A negative
+ *                       status value will be returned if encoding is not
+ *                       successful.
+ */
+EXTERNRT int xe_32BitCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR* pvalue,
+ ASN1TagType tagging, ASN1TAG tag);
+
 /**
  * This function will encode an ASN.1 NULL placeholder.
  *
@@ -1460,6 +2035,22 @@ EXTERNRT int xe_objid
 EXTERNRT int encodeRelOID
 (OSCTXT* pctxt, ASN1OBJID *pvalue, ASN1TagType tagging);
 
+/**
+ * This function encodes a value of the ASN.1 object identifier type held in
+ * compact encoded form. The contents octets are copied as they are.
+ *
+ * @param pctxt        Pointer to context block structure.
+ * @param pvalue       Pointer to value to be encoded.
+ * @param tagging      An enumerated type whose value is set to either
+ *                       'ASN1EXPL' (for explicit tagging) or 'ASN1IMPL' (for
+ *                       implicit).
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int xe_encobjid
+(OSCTXT* pctxt, const ASN1EncOID *pvalue, ASN1TagType tagging);
+
 /**
  * This function encodes a variable of the ASN.1 ENUMERATED type.
  *
@@ -1745,6 +2336,31 @@ RTERR_ENDOFBUF)
  ((pctxt)->buffer.data[(pctxt)->buffer.byteIndex+1] == b2) && \
  ((pctxt)->buffer.data[(pctxt)->buffer.byteIndex+2] == b3))
 
+/* These macros speculatively match the common DER case of a primitive */
+/* single-byte tag followed by a short form length.  The two header    */
+/* bytes are tested as a single 16-bit value.  On a match, the cursor  */
+/* is moved past the header and the constructed flag is cleared; on a  */
+/* mismatch, nothing is changed and the caller falls back to general   */
+/* tag and length parsing.  XD_MATCHHDR2 matches an exact length and   */
+/* XD_MATCHSHORTHDR any short form length, which is returned.          */
+
+#define XD_HDR16(pctxt) \
+((OSUINT16)(((pctxt)->buffer.data[(pctxt)->buffer.byteIndex] << 8) | \
+(pctxt)->buffer.data[(pctxt)->buffer.byteIndex+1]))
+
+#define XD_MATCHHDR2(pctxt, tag, len) \
+((((pctxt)->buffer.byteIndex + 2 <= (pctxt)->buffer.size) && \
+(XD_HDR16(pctxt) == (OSUINT16)(((tag) << 8) | (len)))) ? \
+((pctxt)->flags &= (~ASN1CONSTAG), (pctxt)->buffer.byteIndex += 2, TRUE) : \
+FALSE)
+
+#define XD_MATCHSHORTHDR(pctxt, tag, len_p) \
+((((pctxt)->buffer.byteIndex + 2 <= (pctxt)->buffer.size) && \
+((OSUINT16)(XD_HDR16(pctxt) - ((tag) << 8)) < 0x80)) ? \
+(*(len_p) = (pctxt)->buffer.data[(pctxt)->buffer.byteIndex+1], \
+(pctxt)->flags &= (~ASN1CONSTAG), (pctxt)->buffer.byteIndex += 2, TRUE) : \
+FALSE)
+
 #define XD_MATCHBYTES4(pctxt, b1, b2, b3, b4) \
 (((pctxt)->buffer.data[(pctxt)->buffer.byteIndex] == b1) && \
  ((pctxt)->buffer.data[(pctxt)->buffer.byteIndex+1] == b2) && \
@@ -1779,6 +2395,16 @@ RTERR_ENDOFBUF)
 (((pctxt)->buffer.byteIndex + len) <= (pctxt)->buffer.size)) ? \
 0 : RTERR_ENDOFBUF)
 
+/* This macro will test if the given number of bytes is available in   */
+/* the decode buffer.  Unlike XD_CHKDEFLEN, the test is also done for   */
+/* indefinite length messages.  It is used to validate the contents of  */
+/* a primitive once, after which they are read with unchecked fetches.  */
+
+#define XD_CHKREGION(pctxt,len) \
+((((pctxt)->buffer.byteIndex <= (pctxt)->buffer.size) && \
+((size_t)(len) <= (pctxt)->buffer.size - (pctxt)->buffer.byteIndex)) ? \
+0 : RTERR_ENDOFBUF)
+
 /* This macro will test for EOB */
 
 #define XD_CHKEOB(pctxt) \
@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+/**
+ * @file asn1berPipeline.h
+ * Multi-threaded decoding of files or buffers made up of a sequence of
+ * independent top-level BER records (for example, call detail record
+ * files).
+ */
+#ifndef _ASN1BERPIPELINE_H_
+#define _ASN1BERPIPELINE_H_
+
+#include "rtbersrc/asn1ber.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup berpipeline BER Record Decode Pipeline
+ * @{
+ *
+ * The calling thread splits the input into top-level records and hands
+ * them to a pool of worker threads. Each worker has its own locked queue;
+ * it takes work from the head of its queue and, when that is empty,
+ * steals from the tail of the queues of other workers.
+ * Each record is decoded on a pooled context using the configured decode
+ * function, and the result is passed to the completion function. The
+ * decoded value and any memory allocated while decoding it are only
+ * valid for the duration of the completion call; the context is reset
+ * and reused afterwards.
+ */
+
+/**
+ * Record completion function.
+ *
+ * @param pCbArg       User argument given in the configuration.
+ * @param pctxt        Context the record was decoded on. In case of
+ *                       error, it holds the error information.
+ * @param pvalue       Decoded value.
+ * @param recnum       Zero-based record number in the input.
+ * @param status       Status returned by the decode function.
+ */
+typedef void (*ASN1BerRecDoneFunc)
+(void* pCbArg, OSCTXT* pctxt, void* pvalue, OSSIZE recnum, int status);
+
+typedef struct {
+   int              numThreads;   /* number of worker threads; if <= 0,
+                                     the number of processors is used  */
+   OSSIZE           maxInFlight;  /* max records dispatched but not yet
+                                     completed; if 0, a default based on
+                                     the number of threads is used      */
+   OSBOOL           ordered;      /* deliver completions in record order */
+   size_t           valueSize;    /* size of decoded value; if nonzero, a
+                                     zeroed value is allocated on the
+                                     record context before decoding     */
+   XD_ELEMDECFUNC   decFunc;      /* record decode function; called with
+                                     explicit tagging                   */
+   ASN1BerRecDoneFunc doneFunc;   /* record completion function         */
+   void*            pCbArg;       /* argument passed to doneFunc        */
+} ASN1BerPipelineConfig;
+
+/* Throughput counters.  These may be read while a run is in progress. */
+
+typedef struct {
+   OSSIZE           records;      /* records decoded successfully       */
+   OSSIZE           errors;       /* records that failed to decode      */
+   OSSIZE           bytes;        /* total size of completed records    */
+   OSSIZE           steals;       /* records taken from another worker's
+                                     queue                              */
+} ASN1BerPipelineStats;
+
+typedef struct ASN1BerPipeline ASN1BerPipeline;
+
+/**
+ * This function creates a decode pipeline with the given configuration.
+ *
+ * @param ppPipeline   Pointer to variable to receive the pipeline.
+ * @param pConfig      Pipeline configuration. It is copied.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int berPipelineCreate
+(ASN1BerPipeline** ppPipeline, const ASN1BerPipelineConfig* pConfig);
+
+/**
+ * This function decodes all records in the given buffer. It returns when
+ * all records have been delivered to the completion function. In
+ * unordered mode, the completion function may be called concurrently
+ * from several workers; in ordered mode, calls are serialized and in
+ * record order.
+ *
+ * Decode errors in individual records are reported through the
+ * completion function and do not stop the run. If the input cannot be
+ * split into records, the records before the bad one are decoded and
+ * the split error is returned.
+ *
+ * @param pPipeline    Pointer to pipeline.
+ * @param data         Pointer to buffer containing the records.
+ * @param size         Size of the buffer in bytes.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int berPipelineRunBuffer
+(ASN1BerPipeline* pPipeline, const OSOCTET* data, size_t size);
+
+/**
+ * This function reads the given file and decodes all records in it as
+ * described for berPipelineRunBuffer.
+ *
+ * @param pPipeline    Pointer to pipeline.
+ * @param filename     Name of file containing the records.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int berPipelineRunFile
+(ASN1BerPipeline* pPipeline, const char* filename);
+
+/**
+ * This function returns a snapshot of the counters of the current or
+ * last run. It may be called from any thread.
+ *
+ * @param pPipeline    Pointer to pipeline.
+ * @param pStats       Pointer to structure to receive the counters.
+ */
+EXTERNRT void berPipelineGetStats
+(ASN1BerPipeline* pPipeline, ASN1BerPipelineStats* pStats);
+
+/**
+ * This function releases a pipeline and all memory held by it.
+ *
+ * @param pPipeline    Pointer to pipeline.
+ */
+EXTERNRT void berPipelineFree (ASN1BerPipeline* pPipeline);
+
+/**
+ * @} berpipeline
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
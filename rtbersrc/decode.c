@@ -20,8 +20,27 @@
 #include <string.h>
 #include "asn1ber.h"
 
-static int errTag1NotMatched (OSCTXT *pctxt, OSOCTET expectedTag);
+/* The decode position is at the end of the buffer or, in an indefinite */
+/* length message, past the last end-of-contents marker.                */
+
+#define XD_ATEOB(pctxt) \
+((0 != ((pctxt)->flags & ASN1INDEFLEN)) ? \
+ (((pctxt)->flags & (ASN1INDEFLEN|ASN1LASTEOC)) == \
+  (ASN1INDEFLEN|ASN1LASTEOC)) : \
+ ((pctxt)->buffer.byteIndex >= (pctxt)->buffer.size))
+
+static OSRT_COLD int errTag1NotMatched
+(OSCTXT *pctxt, OSOCTET expectedTag);
+static int matchTag
+(OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags, OSBOOL setErrInfo);
+static int probeMiss
+(OSCTXT* pctxt, int status, int stkx, const ASN1ErrLocn* pFirst);
 static int xd_MovePastEOC (OSCTXT* pctxt);
+static int berScanTLV
+(const OSOCTET* data, size_t size, size_t* pidx, size_t* plast, int depth);
+static int berSkipFast (OSCTXT* pctxt, int depth);
+static OSINT64 fetchInt (OSCTXT* pctxt, int nbytes);
+static OSUINT64 fetchUInt (OSCTXT* pctxt, int nbytes);
 static void saveBufferState (OSCTXT* pCtxt, ASN1BUFSAVE* pSavedInfo);
 static void restoreBufferState (OSCTXT* pCtxt, ASN1BUFSAVE* pSavedInfo);
 
@@ -88,6 +107,71 @@ int xd_bigint
    return 0;
 }
 
+int xd_binbigint
+(OSCTXT *pctxt, ASN1BigInt* pvalue, ASN1TagType tagging, int length)
+{
+   const OSOCTET* data;
+   OSOCTET* pmag;
+   int i, stat, carry;
+
+   if (tagging == ASN1EXPL) {
+      if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
+         return errTag1NotMatched (pctxt, ASN_ID_INT);
+      }
+      stat = XD_LEN (pctxt, &length);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+
+   if (length <= 0) return LOG_RTERR (pctxt, RTERR_INVLEN);
+
+   stat = XD_CHKREGION (pctxt, length);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   data = OSRTBUFPTR (pctxt);
+   XD_BUMPIDX (pctxt, length);
+
+   pvalue->negative = (OSBOOL)((data[0] & 0x80) != 0);
+
+   if (!pvalue->negative) {
+      /* Strip the sign octet and any other leading zeros */
+
+      while (length > 0 && *data == 0) { data++; length--; }
+
+      pvalue->numocts = (OSUINT32)length;
+
+      if ((pctxt->flags & ASN1FASTCOPY) || length == 0) {
+         pvalue->data = data;
+      }
+      else {
+         pmag = (OSOCTET*) rtxMemAlloc (pctxt, length);
+         if (0 == pmag) return LOG_RTERR (pctxt, RTERR_NOMEM);
+         memcpy (pmag, data, length);
+         pvalue->data = pmag;
+      }
+   }
+   else {
+      /* The magnitude of a negative value is its two's complement, */
+      /* which always fits in the same number of octets.            */
+
+      pmag = (OSOCTET*) rtxMemAlloc (pctxt, length);
+      if (0 == pmag) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+      for (i = length - 1, carry = 1; i >= 0; i--) {
+         carry += (OSOCTET)~data[i];
+         pmag[i] = (OSOCTET)carry;
+         carry >>= 8;
+      }
+
+      for (i = 0; i < length - 1 && pmag[i] == 0; i++)
+         ;
+
+      pvalue->numocts = (OSUINT32)(length - i);
+      pvalue->data = pmag + i;
+   }
+
+   return 0;
+}
+
 int xd_bitstr
 (OSCTXT* pctxt, const OSOCTET** pvalue2, OSUINT32* numbits_p,
  ASN1TagType tagging, int length)
@@ -145,11 +229,13 @@ int xd_bitstr_s
    OSOCTET b = 8;
 
    if (tagging == ASN1EXPL) {
-      if (!XD_MATCH1 (pctxt, ASN_ID_BITSTR)) {
-         return errTag1NotMatched (pctxt, ASN_ID_BITSTR);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_BITSTR, &length)) {
+         if (!XD_MATCH1 (pctxt, ASN_ID_BITSTR)) {
+            return errTag1NotMatched (pctxt, ASN_ID_BITSTR);
+         }
+         stat = XD_LEN (pctxt, &length);
+         if (stat != 0) LOG_RTERR (pctxt, stat);
       }
-      stat = XD_LEN (pctxt, &length);
-      if (stat != 0) LOG_RTERR (pctxt, stat);
    }
 
    if (length > 0) {
@@ -188,16 +274,25 @@ int xd_boolean
 (OSCTXT *pctxt, OSBOOL *pvalue, ASN1TagType tagging, int length)
 {
    if (tagging == ASN1EXPL) {
-      if (!XD_MATCH1 (pctxt, ASN_ID_BOOL)) {
-         return errTag1NotMatched (pctxt, ASN_ID_BOOL);
+      if (XD_MATCHHDR2 (pctxt, ASN_ID_BOOL, 1)) {
+         length = 1;
+      }
+      else {
+         if (!XD_MATCH1 (pctxt, ASN_ID_BOOL)) {
+            return errTag1NotMatched (pctxt, ASN_ID_BOOL);
+         }
+         if (XD_CHKREGION (pctxt, 1) != 0)
+            return LOG_RTERR (pctxt, RTERR_ENDOFBUF);
+         length = XD_FETCH1 (pctxt);
       }
-      length = XD_FETCH1 (pctxt);
    }
 
-   if (length == 1)
-      *pvalue = XD_FETCH1 (pctxt);
-   else
+   if (length != 1)
       return LOG_RTERR (pctxt, RTERR_INVLEN);
+   else if (XD_CHKREGION (pctxt, 1) != 0)
+      return LOG_RTERR (pctxt, RTERR_ENDOFBUF);
+
+   *pvalue = XD_FETCH1 (pctxt);
 
    return 0;
 }
@@ -225,9 +320,22 @@ int xd_charstr
    if (ll > 0) {
       char* tmpstr = (char*) rtxMemAlloc (pctxt, ll + 1);
       if (tmpstr) {
-         ll = size;
-         stat = xd_octstr_s (pctxt, (OSOCTET*)tmpstr,
-                             (OSUINT32*) &ll, ASN1IMPL, size);
+         if ((pctxt->flags & (ASN1STRICTSTR|ASN1CONSTAG)) == ASN1STRICTSTR) {
+            /* Check the characters while copying them */
+            stat = XD_CHKREGION (pctxt, ll);
+            if (stat == 0) {
+               stat = rtValidateStrCopy
+                  (tag, tmpstr, (const char*)OSRTBUFPTR (pctxt), (size_t)ll);
+            }
+            if (stat == 0) XD_BUMPIDX (pctxt, ll);
+         }
+         else {
+            ll = size;
+            stat = xd_octstr_s (pctxt, (OSOCTET*)tmpstr,
+                                (OSUINT32*) &ll, ASN1IMPL, size);
+            if (stat == 0 && (pctxt->flags & ASN1STRICTSTR))
+               stat = rtValidateStrCopy (tag, 0, tmpstr, (size_t)ll);
+         }
          if (stat != 0) {
             rtxMemFreePtr (pctxt, tmpstr);
             return LOG_RTERR (pctxt, stat);
@@ -306,6 +414,33 @@ int xd_count (OSCTXT *pctxt, int length, int *count_p)
    ccb.len = length;
    ccb.ptr = OSRTBUFPTR (pctxt);
 
+   /* Scan runs of well-formed elements directly on the buffer.  Anything */
+   /* irregular stops the scan and is handled by the loop below, which    */
+   /* reports the error.                                                  */
+
+   if ((pctxt->flags & (ASN1INDEFLEN | ASN1LASTEOC)) !=
+       (ASN1INDEFLEN | ASN1LASTEOC))
+   {
+      const OSOCTET* data = pctxt->buffer.data;
+      size_t idx = pctxt->buffer.byteIndex, size = pctxt->buffer.size;
+      size_t start = idx, last = idx;
+
+      for (;;) {
+         if (length == ASN_K_INDEFLEN) {
+            if (idx + 2 > size || (data[idx] == 0 && data[idx+1] == 0))
+               break;
+         }
+         else if ((int)(idx - start) >= length || idx >= size)
+            break;
+
+         if (berScanTLV (data, size, &idx, &last, 0) != 0) break;
+         (*count_p)++;
+      }
+
+      if (*count_p > 0) SET_ASN1CONSTAG_BYTE (pctxt, data[last]);
+      pctxt->buffer.byteIndex = idx;
+   }
+
    while (!XD_CHKEND (pctxt, &ccb)) {
       if ((stat = xd_NextElement (pctxt)) == 0) {
          (*count_p)++;
@@ -321,20 +456,118 @@ int xd_count (OSCTXT *pctxt, int length, int *count_p)
    return 0;
 }
 
+static OSBOOL addElemOffset
+(OSCTXT* pctxt, ASN1ElemOffsets* pOffsets, size_t offset)
+{
+   if (pOffsets->count == pOffsets->capacity) {
+      size_t capacity = pOffsets->capacity * 2;
+      size_t* pNew;
+
+      if (pOffsets->pOffsets == pOffsets->local) {
+         pNew = (size_t*) rtxMemAlloc (pctxt, capacity * sizeof(size_t));
+         if (0 != pNew) {
+            memcpy (pNew, pOffsets->local, sizeof(pOffsets->local));
+         }
+      }
+      else pNew = (size_t*) rtxMemRealloc
+         (pctxt, pOffsets->pOffsets, capacity * sizeof(size_t));
+
+      if (0 == pNew) return FALSE;
+
+      pOffsets->pOffsets = pNew;
+      pOffsets->capacity = capacity;
+   }
+
+   pOffsets->pOffsets[pOffsets->count++] = offset;
+
+   return TRUE;
+}
+
+int xd_ElemOffsets (OSCTXT *pctxt, int length, ASN1ElemOffsets* pOffsets)
+{
+   ASN1CCB ccb;
+   int stat = 0;
+
+   pOffsets->pOffsets = pOffsets->local;
+   pOffsets->count = 0;
+   pOffsets->capacity = XD_K_LOCALOFFSETS;
+
+   ccb.len = length;
+   ccb.ptr = OSRTBUFPTR (pctxt);
+
+   /* Scan runs of well-formed elements directly on the buffer as in   */
+   /* xd_count; the loop below handles the rest and reports errors.    */
+
+   if ((pctxt->flags & (ASN1INDEFLEN | ASN1LASTEOC)) !=
+       (ASN1INDEFLEN | ASN1LASTEOC))
+   {
+      const OSOCTET* data = pctxt->buffer.data;
+      size_t idx = pctxt->buffer.byteIndex, size = pctxt->buffer.size;
+      size_t start = idx, last = idx, elemStart;
+
+      for (;;) {
+         if (length == ASN_K_INDEFLEN) {
+            if (idx + 2 > size || (data[idx] == 0 && data[idx+1] == 0))
+               break;
+         }
+         else if ((int)(idx - start) >= length || idx >= size)
+            break;
+
+         elemStart = idx;
+         if (berScanTLV (data, size, &idx, &last, 0) != 0) break;
+         if (!addElemOffset (pctxt, pOffsets, elemStart)) {
+            idx = elemStart;
+            stat = RTERR_NOMEM;
+            break;
+         }
+      }
+
+      if (pOffsets->count > 0) SET_ASN1CONSTAG_BYTE (pctxt, data[last]);
+      pctxt->buffer.byteIndex = idx;
+   }
+
+   while (stat == 0 && !XD_CHKEND (pctxt, &ccb)) {
+      if (!addElemOffset (pctxt, pOffsets, pctxt->buffer.byteIndex))
+         stat = RTERR_NOMEM;
+      else
+         stat = xd_NextElement (pctxt);
+   }
+
+   if (stat != 0) {
+      xd_FreeElemOffsets (pctxt, pOffsets);
+      return LOG_RTERR (pctxt, stat);
+   }
+
+   pOffsets->endIndex = pctxt->buffer.byteIndex;
+
+   return 0;
+}
+
+void xd_FreeElemOffsets (OSCTXT *pctxt, ASN1ElemOffsets* pOffsets)
+{
+   if (pOffsets->pOffsets != pOffsets->local)
+      rtxMemFreePtr (pctxt, pOffsets->pOffsets);
+   pOffsets->pOffsets = pOffsets->local;
+   pOffsets->count = 0;
+   pOffsets->capacity = XD_K_LOCALOFFSETS;
+}
+
 int xd_enum
 (OSCTXT *pctxt, OSINT32 *pvalue, ASN1TagType tagging, int length)
 {
    register int status;
 
    if (tagging == ASN1EXPL) {
-      if (ASN1BUFCUR (pctxt) != ASN_ID_ENUM) {
-         return errTag1NotMatched (pctxt, ASN_ID_ENUM);
-      }
-      else
-         XD_BUMPIDX (pctxt, 1);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_ENUM, &length)) {
+         if (ASN1BUFCUR (pctxt) != ASN_ID_ENUM) {
+            return errTag1NotMatched (pctxt, ASN_ID_ENUM);
+         }
+         else
+            XD_BUMPIDX (pctxt, 1);
 
-      status = XD_LEN (pctxt, &length);
-      if (status != 0) return LOG_RTERR (pctxt, status);
+         status = XD_LEN (pctxt, &length);
+         if (status != 0) return LOG_RTERR (pctxt, status);
+      }
    }
 
    status = xd_integer (pctxt, pvalue, ASN1IMPL, length);
@@ -379,14 +612,16 @@ int xd_enumUnsigned
    register int status;
 
    if (tagging == ASN1EXPL) {
-      if (ASN1BUFCUR (pctxt) != ASN_ID_ENUM) {
-         return errTag1NotMatched (pctxt, ASN_ID_ENUM);
-      }
-      else
-         XD_BUMPIDX (pctxt, 1);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_ENUM, &length)) {
+         if (ASN1BUFCUR (pctxt) != ASN_ID_ENUM) {
+            return errTag1NotMatched (pctxt, ASN_ID_ENUM);
+         }
+         else
+            XD_BUMPIDX (pctxt, 1);
 
-      status = XD_LEN (pctxt, &length);
-      if (status != 0) return LOG_RTERR (pctxt, status);
+         status = XD_LEN (pctxt, &length);
+         if (status != 0) return LOG_RTERR (pctxt, status);
+      }
    }
 
    status = xd_unsigned (pctxt, object_p, ASN1IMPL, length);
@@ -500,14 +735,15 @@ int xd_integer
 (OSCTXT *pctxt, OSINT32 *pvalue, ASN1TagType tagging, int length)
 {
    register int status = 0;
-   OSOCTET	ub;	/* unsigned */
 
    if (tagging == ASN1EXPL) {
-      if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
-         return errTag1NotMatched (pctxt, ASN_ID_INT);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_INT, &length)) {
+         if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
+            return errTag1NotMatched (pctxt, ASN_ID_INT);
+         }
+         status = XD_LEN (pctxt, &length);
+         if (status != 0) return LOG_RTERR (pctxt, status);
       }
-      status = XD_LEN (pctxt, &length);
-      if (status != 0) return LOG_RTERR (pctxt, status);
    }
 
    /* Make sure integer will fit in target variable */
@@ -516,28 +752,13 @@ int xd_integer
       return LOG_RTERR (pctxt, RTERR_TOOBIG);
    }
    else if (length > 0) {
-      status = XD_CHKDEFLEN (pctxt, length);
+      status = XD_CHKREGION (pctxt, length);
       if (status != 0) return LOG_RTERR (pctxt, status);
    }
    else
       return LOG_RTERR (pctxt, RTERR_INVLEN);
 
-   /* Copy first byte into a signed char variable and assign it to */
-   /* object.  This should handle sign extension in the case of a  */
-   /* negative number..                                            */
-
-   if (length > 0) {
-      *pvalue = (signed char) XD_FETCH1 (pctxt);
-      length--;
-   }
-
-   /* Now use unsigned bytes to add in the rest of the integer */
-
-   while (length > 0) {
-      ub = XD_FETCH1 (pctxt);
-      *pvalue = (*pvalue * 256) + ub;
-      length--;
-   }
+   *pvalue = (OSINT32) fetchInt (pctxt, length);
 
    return 0;
 }
@@ -545,16 +766,16 @@ int xd_integer
 int xd_int64 (OSCTXT *pctxt, OSINT64 *object_p,
 	      ASN1TagType tagging, int length)
 {
-   OSOCTET ub; /* unsigned */
-
    if (tagging == ASN1EXPL) {
       int status;
 
-      if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
-         return errTag1NotMatched (pctxt, ASN_ID_INT);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_INT, &length)) {
+         if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
+            return errTag1NotMatched (pctxt, ASN_ID_INT);
+         }
+         status = XD_LEN (pctxt, &length);
+         if (status != 0) return LOG_RTERR (pctxt, status);
       }
-      status = XD_LEN (pctxt, &length);
-      if (status != 0) return LOG_RTERR (pctxt, status);
    }
 
    /* Make sure integer will fit in target variable */
@@ -563,28 +784,13 @@ int xd_int64 (OSCTXT *pctxt, OSINT64 *object_p,
       return LOG_RTERR (pctxt, RTERR_TOOBIG);
    }
    else if (length > 0) {
-      int stat = XD_CHKDEFLEN (pctxt, length);
+      int stat = XD_CHKREGION (pctxt, length);
       if (stat != 0) return LOG_RTERR (pctxt, stat);
    }
    else
       return LOG_RTERR (pctxt, RTERR_INVLEN); /* note: indef len not allowed */
 
-   /* Copy first byte into a signed char variable and assign it to	*/
-   /* object.  This should handle sign extension in the case of a	*/
-   /* negative number..							*/
-
-   if (length > 0) {
-      *object_p = (signed char)XD_FETCH1 (pctxt);;
-      length--;
-   }
-
-   /* Now use unsigned bytes to add in the rest of the integer..	*/
-
-   while (length > 0) {
-      ub = XD_FETCH1 (pctxt);
-      *object_p = (*object_p * 256) + ub;
-      length--;
-   }
+   *object_p = fetchInt (pctxt, length);
 
    return (0);
 }
@@ -621,15 +827,52 @@ int xd_len (OSCTXT *pctxt, int *len_p)
 }
 
 int xd_match (OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags)
+{
+   return matchTag (pctxt, tag, len_p, flags, TRUE);
+}
+
+int xd_probe (OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags)
+{
+   return matchTag (pctxt, tag, len_p, flags, FALSE);
+}
+
+/* Return RTERR_IDNOTFOU for a probe that missed, undoing any errors   */
+/* logged while parsing.                                                 */
+
+static int probeMiss
+(OSCTXT* pctxt, int status, int stkx, const ASN1ErrLocn* pFirst)
+{
+   pctxt->errInfo.status = status;
+   pctxt->errInfo.stkx = stkx;
+   pctxt->errInfo.first = *pFirst;
+   return RTERR_IDNOTFOU;
+}
+
+/* Common code for xd_match and xd_probe.  If the tag is not found,     */
+/* RTERR_IDNOTFOU is returned without logging it; the error information */
+/* is only reset and given the tag parameters if setErrInfo is TRUE.    */
+/* Otherwise it is left as it was on entry.                             */
+
+static int matchTag
+(OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags, OSBOOL setErrInfo)
 {
    int		parsed_len;
    ASN1TAG	parsed_tag;
    ASN1BUFSAVE  savedBufferInfo;
    int          found = FALSE, status;
+   int          errStatus = pctxt->errInfo.status;
+   int          errStkx = pctxt->errInfo.stkx;
+   ASN1ErrLocn  errFirst = pctxt->errInfo.first;
    OSBOOL       constructed;
 
    tag &= ~TM_CONS;
 
+   /* A probe at the end of the buffer misses without going through     */
+   /* xd_tag_len, which logs the end of buffer.  A truncated tag still  */
+   /* logs it, so probeMiss restores the status and its location.       */
+
+   if (!setErrInfo && XD_ATEOB (pctxt)) return RTERR_IDNOTFOU;
+
    /* If skip flag set, advance decode pointer to next field */
 
    if (flags & XM_SKIP)
@@ -645,6 +888,9 @@ int xd_match (OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags)
       else {
          ASN1BUF_RESTORE (pctxt);
          if (status == RTERR_ENDOFBUF) {
+            if (!setErrInfo)
+               return probeMiss (pctxt, errStatus, errStkx, &errFirst);
+
             rtxErrReset (pctxt);
 
             /* If element is optional, do not set error params */
@@ -670,7 +916,10 @@ int xd_match (OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags)
 
    do
    {
-      status = xd_tag_len (pctxt, &parsed_tag, &parsed_len, XM_ADVANCE);
+      if (!setErrInfo && XD_ATEOB (pctxt))
+         status = RTERR_ENDOFBUF;
+      else
+         status = xd_tag_len (pctxt, &parsed_tag, &parsed_len, XM_ADVANCE);
 
       if (status == 0) {
          constructed = (OSBOOL)(0 != (parsed_tag & TM_CONS));
@@ -707,6 +956,9 @@ int xd_match (OSCTXT *pctxt, ASN1TAG tag, int *len_p, OSOCTET flags)
 
       if (status == RTERR_ENDOFBUF || status == 0)
       {
+         if (!setErrInfo)
+            return probeMiss (pctxt, errStatus, errStkx, &errFirst);
+
          rtxErrReset (pctxt);
          berErrAddTagParm (pctxt, tag);          /* expected tag */
          berErrAddTagParm (pctxt, parsed_tag);   /* parsed tag   */
@@ -722,7 +974,17 @@ int xd_match1 (OSCTXT *pctxt, OSOCTET tag, int *len_p)
 {
    int stat, len;
    ASN1BUFFER *pbuffer = &pctxt->buffer;
-   register OSOCTET rtag = pbuffer->data[pbuffer->byteIndex];
+   register OSOCTET rtag;
+
+   /* Speculate on an exact tag match with a short form length */
+
+   if (XD_MATCHSHORTHDR (pctxt, tag, &len)) {
+      SET_ASN1CONSTAG_BYTE (pctxt, tag);
+      if (len_p) *len_p = len;
+      return 0;
+   }
+
+   rtag = pbuffer->data[pbuffer->byteIndex];
 
    if ((rtag & (~TM_FORM)) != (tag & (~TM_FORM))) {
       return errTag1NotMatched (pctxt, tag);
@@ -769,6 +1031,8 @@ int xd_MovePastEOC (OSCTXT* pctxt)
    ASN1TAG tag;
    int ilcnt = 1, len, stat = 0;
 
+   if (berSkipFast (pctxt, 1) == 0) return 0;
+
    while (ilcnt > 0) {
       stat = xd_tag_len (pctxt, &tag, &len, XM_ADVANCE);
       if (stat != 0) break;
@@ -787,6 +1051,8 @@ int xd_NextElement (OSCTXT* pctxt)
    ASN1TAG tag;
    int len, stat;
 
+   if (berSkipFast (pctxt, 0) == 0) return 0;
+
    stat = xd_tag_len (pctxt, &tag, &len, XM_ADVANCE);
    if (stat != 0) return LOG_RTERR (pctxt, stat);
 
@@ -803,7 +1069,7 @@ int xd_NextElement (OSCTXT* pctxt)
 
 int xd_null (OSCTXT *pctxt, ASN1TagType tagging)
 {
-   if (tagging == ASN1EXPL) {
+   if (tagging == ASN1EXPL && !XD_MATCHHDR2 (pctxt, ASN_ID_NULL, 0)) {
       if (!XD_MATCH1 (pctxt, ASN_ID_NULL)) {
          return errTag1NotMatched (pctxt, ASN_ID_NULL);
       }
@@ -882,6 +1148,54 @@ int xd_objid
    return 0;
 }
 
+int xd_encobjid
+(OSCTXT *pctxt, ASN1EncOID *pvalue, const OSRTOIDTable* pTable,
+ ASN1TagType tagging, int length)
+{
+   const OSOCTET* data;
+   int status, i;
+
+   if (tagging == ASN1EXPL) {
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_OBJID, &length)) {
+         if (!XD_MATCH1 (pctxt, ASN_ID_OBJID)) {
+            return errTag1NotMatched (pctxt, ASN_ID_OBJID);
+         }
+         status = XD_LEN (pctxt, &length);
+         if (status != 0) return LOG_RTERR (pctxt, status);
+      }
+   }
+
+   if (length > 0) {
+      status = XD_CHKREGION (pctxt, length);
+      if (status != 0) return LOG_RTERR (pctxt, status);
+   }
+   else
+      return LOG_RTERR (pctxt, RTERR_INVLEN);
+
+   /* Each subidentifier must be minimally encoded and the last octet   */
+   /* must end a subidentifier.  Values are compared octet by octet,    */
+   /* so this also ensures that each OID has only one form.             */
+
+   data = OSRTBUFPTR (pctxt);
+
+   if (data[length - 1] & 0x80)
+      return LOG_RTERR (pctxt, RTERR_INVOBJID);
+
+   for (i = 0; i < length; i++) {
+      if (data[i] == 0x80 && (i == 0 || !(data[i - 1] & 0x80)))
+         return LOG_RTERR (pctxt, RTERR_INVOBJID);
+   }
+
+   pvalue->numocts = (OSUINT32) length;
+   pvalue->data = data;
+   pvalue->handle = (0 != pTable) ?
+      rtxOIDTableFind (pTable, data, (OSUINT32) length) : 0;
+
+   pctxt->buffer.byteIndex += length;
+
+   return 0;
+}
+
 int decodeRelOID
 (OSCTXT *pctxt, ASN1OBJID *pvalue, ASN1TagType tagging, int length)
 {
@@ -989,11 +1303,13 @@ int xd_octstr_s
    int stat = 0;
 
    if (tagging == ASN1EXPL) {
-      if (!XD_MATCH1 (pctxt, ASN_ID_OCTSTR)) {
-         return errTag1NotMatched (pctxt, ASN_ID_OCTSTR);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_OCTSTR, &length)) {
+         if (!XD_MATCH1 (pctxt, ASN_ID_OCTSTR)) {
+            return errTag1NotMatched (pctxt, ASN_ID_OCTSTR);
+         }
+         stat = XD_LEN (pctxt, &length);
+         if (stat != 0) LOG_RTERR (pctxt, stat);
       }
-      stat = XD_LEN (pctxt, &length);
-      if (stat != 0) LOG_RTERR (pctxt, stat);
    }
 
    /* Check length */
@@ -1081,6 +1397,14 @@ int xd_OpenType
    else
       if (status != 0) return LOG_RTERR (pctxt, status);
 
+   /* In fast copy mode, the caller guarantees that the message buffer  */
+   /* outlives the decoded value, so the value references it directly.  */
+
+   if (pctxt->flags & ASN1FASTCOPY) {
+      *pvalue2 = pvalue;
+      return 0;
+   }
+
    *pvalue2 = (const OSOCTET*) rtxMemAlloc (pctxt, *numocts_p);
    if (*pvalue2 != 0)
       memcpy ((void*)*pvalue2, pvalue, *numocts_p);
@@ -1095,17 +1419,20 @@ static int openTypeAppend (OSCTXT *pctxt, OSRTDList *pElemList)
    int stat;
 
    if (0 != pElemList) {
-      ASN1OpenType* pOpenType = rtxMemAllocType (pctxt, ASN1OpenType);
+      OSRTDListNode* pnode;
+      ASN1OpenType* pOpenType;
+
+      rtxDListAllocNodeAndData (pctxt, ASN1OpenType, &pnode, &pOpenType);
       if (pOpenType == NULL) return LOG_RTERR (pctxt, RTERR_NOMEM);
 
       stat = xd_OpenType (pctxt, &pOpenType->data, &pOpenType->numocts);
 
       if (stat != 0) {
-         rtxMemFreePtr (pctxt, pOpenType);
+         rtxMemFreePtr (pctxt, pnode);
          return LOG_RTERR (pctxt, stat);
       }
       else
-         rtxDListAppend (pctxt, pElemList, pOpenType);
+         rtxDListAppendNode (pElemList, pnode);
    }
    else {
       stat = xd_NextElement (pctxt);
@@ -1130,30 +1457,102 @@ int xd_OpenTypeExt(OSCTXT* pctxt, ASN1CCB* ccb_p, ASN1TAG* tags,
       }
    }
    else {
-      /* Only the first tag is checked in the open source version */
-      ASN1TAG tag = tags[0];
+      /* Build a bitmap of the identifier octets of the single-octet     */
+      /* tags in the set.  Tags with ID codes >= 31 are rare here and    */
+      /* are searched for in the tag array.                              */
+
+      OSUINT32 bitmap[8];
+      OSBOOL   longTags = FALSE, found;
+      ASN1TAG  tag;
+      OSOCTET  b;
+      int      i;
+
+      memset (bitmap, 0, sizeof(bitmap));
+
+      for (i = 0; i < tagCount; i++) {
+         tag = tags[i] & ~TM_CONS;
+         if ((tag & TM_IDCODE) < 31) {
+            b = ASN1TAG2BYTE (tag);
+            bitmap[b >> 5] |= (OSUINT32)1 << (b & 31);
+         }
+         else longTags = TRUE;
+      }
 
-      /* Loop through elements until matching tag found or some other   */
-      /* error occurs..                                                 */
+      /* Loop through elements until one with a tag in the set is found */
+      /* or some other error occurs..                                    */
 
-      while ((stat = xd_match (pctxt, tag, &length, 0)) == RTERR_IDNOTFOU) {
+      for (;;) {
+         found = FALSE;
 
-         rtxErrReset (pctxt);
+         if (pctxt->buffer.byteIndex < pctxt->buffer.size) {
+            b = (OSOCTET)(ASN1BUFCUR (pctxt) & ~TM_FORM);
+
+            if ((b & TM_B_IDCODE) != 31) {
+               found = (OSBOOL)((bitmap[b >> 5] >> (b & 31)) & 1);
+            }
+            else if (longTags &&
+                     xd_tag_len (pctxt, &tag, &length, 0) == 0) {
+               tag &= ~TM_CONS;
+               for (i = 0; i < tagCount && !found; i++) {
+                  found = (OSBOOL)(tag == (tags[i] & ~TM_CONS));
+               }
+            }
+         }
+
+         if (found) break;
 
          if (XD_CHKEND (pctxt, ccb_p)) {
             return LOG_RTERR (pctxt, RTERR_ENDOFBUF);
          }
-         else {
-            stat = openTypeAppend (pctxt, pElemList);
-            if (stat != 0) return LOG_RTERR (pctxt, stat);
-         }
+
+         /* Unknown element: add it to the list or, if no list was      */
+         /* given, skip it without copying.                             */
+
+         stat = openTypeAppend (pctxt, pElemList);
+         if (stat != 0) return LOG_RTERR (pctxt, stat);
       }
-      if (stat != 0) return LOG_RTERR (pctxt, stat);
    }
 
    return 0;
 }
 
+int xd_SeqOfElems
+(OSCTXT* pctxt, OSRTDList* pList, size_t elemSize, int length,
+ XD_ELEMDECFUNC decFunc)
+{
+   ASN1ElemOffsets offsets;
+   OSRTDListNode* pnode;
+   size_t i;
+   int stat;
+
+   stat = xd_ElemOffsets (pctxt, length, &offsets);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   if (offsets.count == 0) return 0;
+
+   pnode = rtxDListAllocNodesAndData (pctxt, pList, offsets.count, elemSize);
+   if (0 == pnode) stat = RTERR_NOMEM;
+
+   /* Decode each element from the start recorded by the scan.  It    */
+   /* must end where the scan found the next element to start.         */
+
+   for (i = 0; stat == 0 && i < offsets.count; i++, pnode = pnode->next) {
+      pctxt->buffer.byteIndex = offsets.pOffsets[i];
+      stat = decFunc (pctxt, pnode->data, ASN1EXPL, 0);
+      if (stat == 0 && pctxt->buffer.byteIndex !=
+          ((i + 1 < offsets.count) ?
+           offsets.pOffsets[i + 1] : offsets.endIndex))
+         stat = RTERR_BADVALUE;
+   }
+
+   xd_FreeElemOffsets (pctxt, &offsets);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   pctxt->buffer.byteIndex = offsets.endIndex;
+
+   return 0;
+}
+
 int xd_setp
 (OSCTXT *pctxt, const OSOCTET* msg_p,
  int msglen, ASN1TAG *tag_p, int *len_p)
@@ -1255,20 +1654,10 @@ int xd_tag_len
 (OSCTXT *pctxt, ASN1TAG *tag_p, int *len_p, OSOCTET flags)
 {
    int stat;
-   OSUINT16 mask = ASN1INDEFLEN | ASN1LASTEOC;
 
    /* Check for attempt to read past EOB */
 
-   if (0 != (pctxt->flags & ASN1INDEFLEN)) {
-      if ((pctxt->flags & mask) == mask)
-         return LOG_RTERR(pctxt, RTERR_ENDOFBUF);
-   }
-   else {
-      register size_t usedBytes =
-         OSRTBUFPTR(pctxt) - pctxt->buffer.data;
-      if (usedBytes >= pctxt->buffer.size)
-         return LOG_RTERR(pctxt, RTERR_ENDOFBUF);
-   }
+   if (XD_ATEOB (pctxt)) return LOG_RTERR(pctxt, RTERR_ENDOFBUF);
 
    /* Save context prior to parsing this tag and length.  It may be	*/
    /* used by generated decode functions to restore the decode point if	*/
@@ -1304,6 +1693,83 @@ int xd_tag_len
    return 0;
 }
 
+int xd_TagDispatchInit
+(ASN1TagDispatch* pDisp, const ASN1TAG* pTags, OSUINT32 numTags)
+{
+   OSUINT32 i, j;
+   OSOCTET  b;
+   ASN1TAG  tag;
+
+   if (0 == pDisp || (0 == pTags && numTags > 0)) return RTERR_NULLPTR;
+   if (numTags > ASN1_K_MaxSetElements) return RTERR_TOOMANY;
+
+   for (i = 0; i < 256; i++) pDisp->index1[i] = -1;
+
+   for (i = 0; i < numTags; i++) {
+      tag = pTags[i] & ~TM_CONS;
+
+      if ((tag & TM_IDCODE) < 31) {
+         b = ASN1TAG2BYTE (tag);
+         if (pDisp->index1[b] >= 0) return RTERR_INVPARAM;
+
+         /* Enter both primitive and constructed forms */
+         pDisp->index1[b] = pDisp->index1[b | TM_FORM] = (OSINT16)i;
+      }
+      else {
+         for (j = 0; j < i; j++) {
+            if ((pTags[j] & ~TM_CONS) == tag) return RTERR_INVPARAM;
+         }
+      }
+   }
+
+   pDisp->pTags = pTags;
+   pDisp->numTags = numTags;
+
+   return 0;
+}
+
+int xd_TagDispatch
+(OSCTXT* pctxt, const ASN1TagDispatch* pDisp, ASN1CCB* ccb_p,
+ int* pindex, int* len_p)
+{
+   ASN1TAG  tag;
+   OSUINT32 i;
+   int      idx = -1, stat;
+
+   stat = xd_tag_len (pctxt, &tag, len_p, XM_ADVANCE);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   tag &= ~TM_CONS;
+
+   if ((tag & TM_IDCODE) < 31) {
+      idx = pDisp->index1[ASN1TAG2BYTE (tag)];
+   }
+   else {
+      for (i = 0; i < pDisp->numTags; i++) {
+         if ((pDisp->pTags[i] & ~TM_CONS) == tag) { idx = (int)i; break; }
+      }
+   }
+
+   if (idx < 0) {
+      /* Only return status, do not log error.  Caller decides whether */
+      /* the element is an extension to be skipped or an error.        */
+      ASN1BUF_RESTORE (pctxt);
+      return RTERR_IDNOTFOU;
+   }
+
+   if (0 != ccb_p) {
+      OSUINT16 bit = (OSUINT16)(1u << (idx % ASN1_K_NumBitsPerMask));
+      OSUINT16* pword = &ccb_p->mask[idx / ASN1_K_NumBitsPerMask];
+
+      if (*pword & bit) return LOG_RTERR (pctxt, RTERR_SETDUPL);
+      *pword |= bit;
+   }
+
+   *pindex = idx;
+
+   return 0;
+}
+
 int xd_uint16
 (OSCTXT *pctxt, OSUINT16 *pvalue, ASN1TagType tagging, int length)
 {
@@ -1389,14 +1855,15 @@ int xd_uint
 (OSCTXT *pctxt, OSUINT32 *pvalue, ASN1TagType tagging, int length)
 {
    register int	status = 0;
-   OSOCTET	ub;	/* unsigned */
 
    if (tagging == ASN1EXPL) {
-      if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
-         return errTag1NotMatched (pctxt, ASN_ID_INT);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_INT, &length)) {
+         if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
+            return errTag1NotMatched (pctxt, ASN_ID_INT);
+         }
+         status = XD_LEN (pctxt, &length);
+         if (status != 0) return LOG_RTERR (pctxt, status);
       }
-      status = XD_LEN (pctxt, &length);
-      if (status != 0) return LOG_RTERR (pctxt, status);
    }
 
    if (status == 0) {
@@ -1409,16 +1876,13 @@ int xd_uint
             return LOG_RTERR (pctxt, RTERR_TOOBIG);
       }
 
-      /* Use unsigned bytes to decode unsigned integer.. */
-
-      *pvalue = 0;
+      /* Validate contents once, then decode using unchecked fetches */
 
-      while (length > 0 && status == 0) {
-         if ((status = XD_MEMCPY1 (pctxt, &ub)) == 0) {
-            *pvalue = (*pvalue * 256) + ub;
-            length--;
-         }
+      if (length > 0) {
+         status = XD_CHKREGION (pctxt, length);
+         if (status == 0) *pvalue = (OSUINT32) fetchUInt (pctxt, length);
       }
+      else *pvalue = 0;
    }
 
    if (status != 0) return LOG_RTERR (pctxt, status);
@@ -1428,16 +1892,17 @@ int xd_uint
 int xd_uint64 (OSCTXT *pctxt, OSUINT64 *object_p,
                ASN1TagType tagging, int length)
 {
-   OSOCTET      ub;     /* unsigned */
    int          stat;
    OSBOOL       negative;
 
    if (tagging == ASN1EXPL) {
-      if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
-         return errTag1NotMatched (pctxt, ASN_ID_INT);
+      if (!XD_MATCHSHORTHDR (pctxt, ASN_ID_INT, &length)) {
+         if (!XD_MATCH1 (pctxt, ASN_ID_INT)) {
+            return errTag1NotMatched (pctxt, ASN_ID_INT);
+         }
+         stat = XD_LEN (pctxt, &length);
+         if (stat != 0) return LOG_RTERR (pctxt, stat);
       }
-      stat = XD_LEN (pctxt, &length);
-      if (stat != 0) return LOG_RTERR (pctxt, stat);
    }
 
    /* if the length is zero, return 0 */
@@ -1445,6 +1910,12 @@ int xd_uint64 (OSCTXT *pctxt, OSUINT64 *object_p,
       *object_p = 0;
       return 0;
    }
+   else if (length < 0) {
+      return LOG_RTERR (pctxt, RTERR_INVLEN);
+   }
+
+   stat = XD_CHKREGION (pctxt, length);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
 
    /* Verify that encoded value is not negative */
 
@@ -1463,21 +1934,10 @@ int xd_uint64 (OSCTXT *pctxt, OSUINT64 *object_p,
 
       XD_BUMPIDX (pctxt, 1); /* skip it */
 
-      if ((stat = XD_CHKDEFLEN (pctxt, 1)) != 0)
-         return LOG_RTERR (pctxt, stat);
-
       length--;
    }
 
-   /* Use unsigned bytes to decode unsigned integer.. */
-
-   *object_p = 0;
-
-   while (length > 0) {
-      ub = XD_FETCH1 (pctxt);
-      *object_p = (*object_p * 256) + ub;
-      length--;
-   }
+   *object_p = fetchUInt (pctxt, length);
 
    if (negative) {
       OSINT64 signedValue = (OSINT64) *object_p;
@@ -1490,12 +1950,41 @@ int xd_uint64 (OSCTXT *pctxt, OSUINT64 *object_p,
    return 0;
 }
 
+/* Get the contents octets of a character string.  Primitive contents  */
+/* are used in place in the decode buffer; the segments of a            */
+/* constructed string are joined in the given buffer of *plen octets.   */
+
+static int getCharStrOcts
+(OSCTXT* pctxt, OSOCTET* buffer, const OSOCTET** ppdata, int* plen)
+{
+   OSUINT32 numocts;
+   int stat;
+
+   if (pctxt->flags & ASN1CONSTAG) {
+      numocts = (OSUINT32)*plen;
+      stat = xd_octstr_s (pctxt, buffer, &numocts, ASN1IMPL, *plen);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+      *ppdata = buffer;
+      *plen = (int)numocts;
+   }
+   else {
+      if (XD_CHKREGION (pctxt, *plen) != 0)
+         return LOG_RTERR (pctxt, RTERR_ENDOFBUF);
+
+      *ppdata = OSRTBUFPTR (pctxt);
+      XD_BUMPIDX (pctxt, *plen);
+   }
+
+   return 0;
+}
+
 int xd_16BitCharStr (OSCTXT* pctxt, Asn116BitCharString* pvalue,
                      ASN1TagType tagging, ASN1TAG tag, int length)
 {
-   OSUINT32   i;
    OSINT32    stat = 0, isConstructedTag;
    OSOCTET* data = 0;
+   const OSOCTET* src;
    OSUINT32   nchars = 0;
    OS16BITCHAR* data16 = 0;
 
@@ -1526,16 +2015,13 @@ int xd_16BitCharStr (OSCTXT* pctxt, Asn116BitCharString* pvalue,
       data16 = (OS16BITCHAR*) data;
 
       if (0 != data) {
-         ll = size;
-         if ((stat = xd_octstr_s
-              (pctxt, data, (OSUINT32*) &ll, ASN1IMPL, size)) != 0) {
-            rtxMemFreePtr (pctxt, data);
+         stat = getCharStrOcts (pctxt, data, &src, &ll);
+         if (stat != 0) {
+            rtxMemFreePtr (pctxt, data16);
             return LOG_RTERR (pctxt, stat);
          }
          nchars = ll / 2;
-         for (i = 0; i < nchars; i++, data += 2) {
-            data16[i] = (OS16BITCHAR) ((data[0] * 256) + data[1]);
-         }
+         rtxBMPCharsFromBE (src, nchars, data16);
       }
       else
          return LOG_RTERR (pctxt, RTERR_NOMEM);
@@ -1556,9 +2042,9 @@ int xd_16BitCharStr (OSCTXT* pctxt, Asn116BitCharString* pvalue,
 int xd_32BitCharStr (OSCTXT* pctxt, Asn132BitCharString* pvalue,
                      ASN1TagType tagging, ASN1TAG tag, int length)
 {
-   OSUINT32   i;
    OSINT32    stat = 0, isConstructedTag;
    OSOCTET* data = 0;
+   const OSOCTET* src;
    OSUINT32   nchars = 0;
    OS32BITCHAR* data32 = 0;
 
@@ -1589,17 +2075,13 @@ int xd_32BitCharStr (OSCTXT* pctxt, Asn132BitCharString* pvalue,
       data32 = (OS32BITCHAR*)data;
 
       if (0 != data) {
-         ll = size;
-         if ((stat = xd_octstr_s
-              (pctxt, data, (OSUINT32*) &ll, ASN1IMPL, size)) != 0) {
-            rtxMemFreePtr (pctxt, data);
+         stat = getCharStrOcts (pctxt, data, &src, &ll);
+         if (stat != 0) {
+            rtxMemFreePtr (pctxt, data32);
             return LOG_RTERR (pctxt, stat);
          }
          nchars = ll / 4;
-         for (i = 0; i < nchars; i++, data += 4) {
-            data32[i] = (OS32BITCHAR) (((data[0] * 256) + data[1]) *
-               65536UL + (((data[2] * 256) + data[3])));
-         }
+         rtxUCS4CharsFromBE (src, nchars, data32);
       }
       else
          return LOG_RTERR (pctxt, RTERR_NOMEM);
@@ -1617,6 +2099,71 @@ int xd_32BitCharStr (OSCTXT* pctxt, Asn132BitCharString* pvalue,
    return 0;
 }
 
+/* Decode a BMPString or UniversalString directly to UTF-8 */
+
+static int decodeCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR** ppvalue, ASN1TagType tagging,
+ ASN1TAG tag, int length, size_t width)
+{
+   OSOCTET* buffer = 0;
+   const OSOCTET* src = 0;
+   OSUTF8CHAR* pstr = 0;
+   int stat = 0, len = 0;
+
+   if (0 == ppvalue) return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   if (tagging == ASN1EXPL) {
+      if ((stat = xd_match1 (pctxt, ASN1TAG2BYTE(tag), &length)) < 0)
+         /* RTERR_IDNOTFOU will be logged later, by the generated code,
+            or reset by rtxErrReset (for optional seq elements). */
+         return (stat == RTERR_IDNOTFOU) ? stat : LOG_RTERR (pctxt, stat);
+   }
+   if (length == ASN_K_INDEFLEN) return LOG_RTERR (pctxt, RTERR_NOTSUPP);
+
+   /* Only the segments of a constructed string need a work buffer */
+
+   if ((pctxt->flags & ASN1CONSTAG) && length > 0) {
+      buffer = (OSOCTET*) rtxMemAlloc (pctxt, length);
+      if (0 == buffer) return LOG_RTERR (pctxt, RTERR_NOMEM);
+   }
+
+   stat = getCharStrOcts (pctxt, buffer, &src, &length);
+
+   if (stat == 0) {
+      len = stat = (width == 2) ?
+         rtxBMPToUTF8 (src, (size_t)length, 0, 0) :
+         rtxUCS4ToUTF8 (src, (size_t)length, 0, 0);
+   }
+   if (stat >= 0) {
+      pstr = (OSUTF8CHAR*) rtxMemAlloc (pctxt, len + 1);
+      if (0 == pstr) stat = RTERR_NOMEM;
+      else {
+         stat = (width == 2) ?
+            rtxBMPToUTF8 (src, (size_t)length, pstr, len + 1) :
+            rtxUCS4ToUTF8 (src, (size_t)length, pstr, len + 1);
+         if (stat < 0) rtxMemFreePtr (pctxt, pstr);
+      }
+   }
+
+   if (0 != buffer) rtxMemFreePtr (pctxt, buffer);
+   if (stat < 0) return LOG_RTERR (pctxt, stat);
+
+   *ppvalue = pstr;
+   return 0;
+}
+
+int xd_16BitCharStrUTF8 (OSCTXT* pctxt, const OSUTF8CHAR** ppvalue,
+                         ASN1TagType tagging, ASN1TAG tag, int length)
+{
+   return decodeCharStrUTF8 (pctxt, ppvalue, tagging, tag, length, 2);
+}
+
+int xd_32BitCharStrUTF8 (OSCTXT* pctxt, const OSUTF8CHAR** ppvalue,
+                         ASN1TagType tagging, ASN1TAG tag, int length)
+{
+   return decodeCharStrUTF8 (pctxt, ppvalue, tagging, tag, length, 4);
+}
+
 /**
  * Single-byte tag not matched error
  */
@@ -1647,6 +2194,139 @@ static void restoreBufferState (OSCTXT* pCtxt, ASN1BUFSAVE* pSavedInfo)
    pCtxt->flags = (pSavedInfo->flags & (~ASN1LASTEOC));
 }
 
+/**
+ * Scan past complete TLV elements starting at *pidx.  No context
+ * bookkeeping is done.  If depth is zero, one element is skipped;
+ * otherwise elements are skipped until depth end-of-contents markers
+ * have been consumed.  On success, *pidx is set to the index following
+ * the scanned data and *plast to the start of the last tag parsed.  A
+ * nonzero status is returned for anything irregular; callers then fall
+ * back to the element-by-element parse, which logs the error.
+ */
+static int berScanTLV
+(const OSOCTET* data, size_t size, size_t* pidx, size_t* plast, int depth)
+{
+   size_t idx = *pidx, last = idx, len;
+   OSUINT32 idcode;
+   OSOCTET b, lb;
+   int i;
+
+   do {
+      if (idx >= size || size - idx < 2) return RTERR_ENDOFBUF;
+
+      last = idx;
+      b = data[idx++];
+      idcode = b & TM_B_IDCODE;
+
+      /* Multi-byte identifier; at most 4 subsequent octets are accepted */
+      /* here so the code cannot overflow.                               */
+
+      if (idcode == TM_B_IDCODE) {
+         i = 0; idcode = 0;
+         do {
+            if (idx >= size || i++ >= 4) return RTERR_BADTAG;
+            lb = data[idx++];
+            idcode = (idcode * 128) + (lb & 0x7F);
+         } while (lb & 0x80);
+
+         if (idx >= size) return RTERR_ENDOFBUF;
+      }
+
+      lb = data[idx++];
+
+      if (lb < 0x80) len = lb;
+      else if (lb == 0x80) {
+         /* Indefinite length is only valid on a constructed tag */
+         if (0 == (b & TM_FORM)) return RTERR_INVLEN;
+         depth++;
+         continue;
+      }
+      else {
+         i = lb & 0x7F;
+         if (i > 4 || size - idx < (size_t)i) return RTERR_INVLEN;
+         for (len = 0; i > 0; i--) len = (len * 256) + data[idx++];
+      }
+
+      if (len > size - idx || len > (size_t)INT_MAX) return RTERR_INVLEN;
+      idx += len;
+
+      /* End-of-contents marker closes the innermost indefinite length */
+
+      if (len == 0 && depth > 0 && 0 == (b & TM_CLASS_FORM) && idcode == 0)
+         depth--;
+
+   } while (depth > 0);
+
+   *pidx = idx;
+   *plast = last;
+
+   return 0;
+}
+
+/**
+ * Skip past elements in the decode buffer using berScanTLV.  The context
+ * is only updated if the scan succeeds, in which case the saved buffer
+ * info and constructed tag flag are left as xd_tag_len would have left
+ * them for the last tag parsed.
+ */
+static int berSkipFast (OSCTXT* pctxt, int depth)
+{
+   OSUINT16 mask = ASN1INDEFLEN | ASN1LASTEOC;
+   size_t idx = pctxt->buffer.byteIndex, last;
+   int stat;
+
+   if ((pctxt->flags & mask) == mask) return RTERR_ENDOFBUF;
+
+   stat = berScanTLV
+      (pctxt->buffer.data, pctxt->buffer.size, &idx, &last, depth);
+
+   if (stat == 0) {
+      pctxt->savedInfo.byteIndex = last;
+      pctxt->savedInfo.flags = pctxt->flags;
+      SET_ASN1CONSTAG_BYTE (pctxt, pctxt->buffer.data[last]);
+      pctxt->buffer.byteIndex = idx;
+   }
+
+   return stat;
+}
+
+/**
+ * Read a big-endian two's complement integer of the given number of bytes
+ * (1 to 8) at the decode cursor.  No bounds checking is done; the bytes
+ * must have been validated using XD_CHKREGION.  The exact number of bytes
+ * is read, as the buffer size does not always reflect the memory actually
+ * available (see xd_setp).
+ */
+static OSINT64 fetchInt (OSCTXT* pctxt, int nbytes)
+{
+   const OSOCTET* p = OSRTBUFPTR (pctxt);
+   OSUINT64 value = (p[0] & 0x80) ? ~((OSUINT64)0) : 0;
+   int i;
+
+   for (i = 0; i < nbytes; i++) value = (value << 8) | p[i];
+
+   pctxt->buffer.byteIndex += nbytes;
+
+   return (OSINT64) value;
+}
+
+/**
+ * Read a big-endian unsigned integer of the given number of bytes (0 to
+ * 8) at the decode cursor.  No bounds checking is done, as for fetchInt.
+ */
+static OSUINT64 fetchUInt (OSCTXT* pctxt, int nbytes)
+{
+   const OSOCTET* p = OSRTBUFPTR (pctxt);
+   OSUINT64 value = 0;
+   int i;
+
+   for (i = 0; i < nbytes; i++) value = (value << 8) | p[i];
+
+   pctxt->buffer.byteIndex += nbytes;
+
+   return value;
+}
+
 /* Add an ASN.1 tag parameter to an error message */
 
 static const char* rtTagToString (ASN1TAG tag, char* buffer, size_t bufsiz)
@@ -1673,8 +2353,7 @@ static const char* rtTagToString (ASN1TAG tag, char* buffer, size_t bufsiz)
 
 int berErrAddTagParm (OSCTXT* pctxt, ASN1TAG errParm)
 {
-   char lbuf[32];
-   rtTagToString (errParm, lbuf, sizeof(lbuf));
-   return rtxErrAddStrParm (pctxt, lbuf);
+   /* Tag text is only built if the error text is requested */
+   return rtxErrAddLazyParm (pctxt, rtTagToString, errParm);
 }
 
@@ -169,6 +169,58 @@ int xe_bigint
    return (int)(aal);
 }
 
+int xe_binbigint
+(OSCTXT* pctxt, const ASN1BigInt* pvalue, ASN1TagType tagging)
+{
+   static const OSOCTET signOcts[] = { 0x00, 0xFF };
+   const OSOCTET* data;
+   OSOCTET* pcur;
+   size_t numocts, i;
+   int aal, carry;
+
+   if (0 == pvalue || (0 == pvalue->data && pvalue->numocts > 0))
+      return LOG_RTERR (pctxt, RTERR_BADVALUE);
+
+   /* Leading zero octets of the magnitude are not significant */
+
+   data = pvalue->data;
+   for (numocts = pvalue->numocts; numocts > 0 && *data == 0; numocts--)
+      data++;
+
+   if (numocts == 0) {
+      aal = xe_memcpy (pctxt, signOcts, 1);
+   }
+   else {
+      aal = xe_memcpy (pctxt, data, numocts);
+      if (aal < 0) return LOG_RTERR (pctxt, aal);
+
+      pcur = OSRTBUFPTR (pctxt);
+
+      if (pvalue->negative) {
+         /* Replace the magnitude with its two's complement in place */
+
+         for (i = numocts, carry = 1; i > 0; i--) {
+            carry += (OSOCTET)~pcur[i - 1];
+            pcur[i - 1] = (OSOCTET)carry;
+            carry >>= 8;
+         }
+      }
+
+      /* Add a sign octet if the leading bit does not match the sign */
+
+      if (((pcur[0] & 0x80) != 0) != (pvalue->negative != 0)) {
+         int ll = xe_memcpy (pctxt, &signOcts[pvalue->negative ? 1 : 0], 1);
+         if (ll < 0) return LOG_RTERR (pctxt, ll);
+         aal += ll;
+      }
+   }
+
+   if (tagging == ASN1EXPL && aal >= 0)
+      aal = xe_tag_len (pctxt, TM_UNIV|TM_PRIM|ASN_ID_INT, aal);
+
+   return (aal);
+}
+
 int xe_bitstr
 (OSCTXT* pctxt, const OSOCTET* pvalue, OSUINT32 numbits,
  ASN1TagType tagging)
@@ -201,26 +253,66 @@ int xe_bitstr
    return (aal);
 }
 
+/* Parse the tag and length at the start of an encoded open type value */
+/* and return the total length of the TLV.  The checks are the same as */
+/* those done when decoding it with xd_setp.                            */
+
+static int openTypeLength (const OSOCTET* data, OSUINT32 numocts)
+{
+   OSUINT32 idx = 1, idcode = 0, len;
+   OSBOOL   constructed = (OSBOOL)((data[0] & TM_FORM) != 0);
+   OSOCTET  b = data[0];
+   int      i;
+
+   if ((b & TM_B_IDCODE) == 31) {
+      i = 0;
+      do {
+         if (idx >= numocts) return RTERR_ENDOFBUF;
+         b = data[idx++];
+         idcode = (idcode * 128) + (b & 0x7F);
+         if (idcode > TM_IDCODE || i++ > 8) return RTERR_BADTAG;
+      } while (b & 0x80);
+   }
+
+   if (idx >= numocts) return RTERR_ENDOFBUF;
+   b = data[idx++];
+
+   if (b == 0x80) {
+      return (constructed) ? RTERR_NOTSUPP : RTERR_INVLEN;
+   }
+   else if (b > 0x80) {
+      i = b & 0x7F;
+      if (i > 4 || (OSUINT32)i > numocts - idx) return RTERR_INVLEN;
+      for (len = 0; i > 0; i--) {
+         len = (len * 256) + data[idx++];
+      }
+   }
+   else len = b;
+
+   if (len > numocts - idx) return RTERR_INVLEN;
+
+   /* EOC is not allowed as OpenType */
+   if (data[0] == 0 && len == 0) return RTERR_BADVALUE;
+
+   return (int)(idx + len);
+}
+
 int xe_OpenType
 (OSCTXT* pctxt, const OSOCTET* pvalue, OSUINT32 numocts)
 {
-   OSCTXT lctxt;
-   int aal = 0, already_encoded, len, stat;
-   ASN1TAG tag;
+   int aal = 0, already_encoded, len;
 
    if (numocts > 0) {
       if (0 == pvalue) return LOG_RTERR(pctxt, RTERR_BADVALUE);
 
-      if ((stat = rtInitContext (&lctxt)) != 0)
-         return LOG_RTERR(pctxt, stat);
-
-      stat = xd_setp (&lctxt, pvalue, numocts, &tag, &len);
-      rtFreeContext (&lctxt);
+      len = openTypeLength (pvalue, numocts);
 
-      if (stat != 0) return LOG_RTERR (pctxt, stat);
+      /* For an indefinite length message, need to get the actual 	*/
+      /* length by parsing tags until the end of the message is 	*/
+      /* reached..							*/
 
-      if (tag == 0 && len == 0) /* EOC is not allowed as OpenType */
-         return LOG_RTERR(pctxt, RTERR_BADVALUE);
+      if (len == RTERR_NOTSUPP) return RTERR_NOTSUPP;
+      else if (len < 0) return LOG_RTERR (pctxt, len);
 
       /* An any field is considered to be already encoded if the given	*/
       /* pointer is equal to the current encode pointer.  This will be	*/
@@ -229,14 +321,6 @@ int xe_OpenType
 
       already_encoded = (pvalue == OSRTBUFPTR(pctxt));
 
-      /* For an indefinite length message, need to get the actual 	*/
-      /* length by parsing tags until the end of the message is 	*/
-      /* reached..							*/
-
-      if (len == ASN_K_INDEFLEN) {  /* indefinite length message */
-         return RTERR_NOTSUPP;
-      }
-
       /* If not already copied, copy message component to encode buffer	*/
 
       aal = (already_encoded) ?
@@ -310,22 +394,35 @@ int xe_charstr (OSCTXT* pctxt, const char* pvalue,
    return (ll0);
 }
 
+/* Reserve space for the contents of a string in the encode buffer */
+
+static int reserveContents (OSCTXT* pctxt, size_t length)
+{
+   if (length > (size_t)OSINT32_MAX) return LOG_RTERR (pctxt, RTERR_TOOBIG);
+
+   if (length > pctxt->buffer.byteIndex) {
+      int stat = xe_expandBuffer (pctxt, length);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+   pctxt->buffer.byteIndex -= length;
+
+   return 0;
+}
+
 int xe_16BitCharStr
 (OSCTXT* pctxt, Asn116BitCharString* pvalue,
  ASN1TagType tagging, ASN1TAG tag)
 {
-   OSOCTET lbuf[2];
-   int i, ll, ll0 = 0;
+   int stat, ll0;
 
-   if (0 == pvalue) return LOG_RTERR(pctxt, RTERR_BADVALUE);
+   if (0 == pvalue || (0 == pvalue->data && pvalue->nchars > 0))
+      return LOG_RTERR(pctxt, RTERR_BADVALUE);
 
-   for (i = pvalue->nchars - 1; i >= 0; i--) {
-      lbuf[0] = (OSOCTET) (pvalue->data[i] / 256);
-      lbuf[1] = (OSOCTET) (pvalue->data[i] % 256);
+   stat = reserveContents (pctxt, (size_t)pvalue->nchars * 2);
+   if (stat != 0) return stat;
 
-      ll = xe_memcpy (pctxt, lbuf, 2);
-      if (ll >= 0) ll0 += ll; else return (ll);
-   }
+   rtxBMPCharsToBE (pvalue->data, pvalue->nchars, OSRTBUFPTR (pctxt));
+   ll0 = (int)pvalue->nchars * 2;
 
    if (tagging == ASN1EXPL)
       ll0 = xe_tag_len (pctxt, tag, ll0);
@@ -337,21 +434,47 @@ int xe_32BitCharStr
 (OSCTXT* pctxt, Asn132BitCharString* pvalue,
  ASN1TagType tagging, ASN1TAG tag)
 {
-   OSOCTET lbuf[4];
-   int i, ll, ll0 = 0;
+   int stat, ll0;
+
+   if (0 == pvalue || (0 == pvalue->data && pvalue->nchars > 0))
+      return LOG_RTERR(pctxt, RTERR_BADVALUE);
+
+   stat = reserveContents (pctxt, (size_t)pvalue->nchars * 4);
+   if (stat != 0) return stat;
+
+   rtxUCS4CharsToBE (pvalue->data, pvalue->nchars, OSRTBUFPTR (pctxt));
+   ll0 = (int)pvalue->nchars * 4;
+
+   if (tagging == ASN1EXPL)
+      ll0 = xe_tag_len (pctxt, tag, ll0);
+
+   return (ll0);
+}
+
+/* Encode a UTF-8 string as a BMPString or UniversalString */
+
+static int encodeCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR* pvalue, ASN1TagType tagging,
+ ASN1TAG tag, size_t width)
+{
+   size_t nbytes;
+   int stat, ll0;
 
    if (0 == pvalue) return LOG_RTERR(pctxt, RTERR_BADVALUE);
 
-   for (i = pvalue->nchars - 1; i >= 0; i--) {
-      OS32BITCHAR sym = pvalue->data[i];
-      lbuf[0] = (OSOCTET) (sym / 256 / 256 / 256);
-      lbuf[1] = (OSOCTET) (sym / 256 / 256 % 256);
-      lbuf[2] = (OSOCTET) (sym / 256 % 256 );
-      lbuf[3] = (OSOCTET) (sym % 256);
+   nbytes = strlen ((const char*)pvalue);
 
-      ll = xe_memcpy (pctxt, lbuf, 4);
-      if (ll >= 0) ll0 += ll; else return (ll);
-   }
+   ll0 = (width == 2) ? rtxUTF8ToBMP (pvalue, nbytes, 0, 0) :
+      rtxUTF8ToUCS4 (pvalue, nbytes, 0, 0);
+   if (ll0 < 0) return LOG_RTERR (pctxt, ll0);
+
+   stat = reserveContents (pctxt, (size_t)ll0);
+   if (stat != 0) return stat;
+
+   if (width == 2)
+      rtxUTF8ToBMP (pvalue, nbytes, OSRTBUFPTR (pctxt), (size_t)ll0);
+   else
+      rtxUTF8ToUCS4 (pvalue, nbytes, OSRTBUFPTR (pctxt), (size_t)ll0);
 
    if (tagging == ASN1EXPL)
       ll0 = xe_tag_len (pctxt, tag, ll0);
@@ -359,6 +482,20 @@ int xe_32BitCharStr
    return (ll0);
 }
 
+int xe_16BitCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR* pvalue,
+ ASN1TagType tagging, ASN1TAG tag)
+{
+   return encodeCharStrUTF8 (pctxt, pvalue, tagging, tag, 2);
+}
+
+int xe_32BitCharStrUTF8
+(OSCTXT* pctxt, const OSUTF8CHAR* pvalue,
+ ASN1TagType tagging, ASN1TAG tag)
+{
+   return encodeCharStrUTF8 (pctxt, pvalue, tagging, tag, 4);
+}
+
 static int xe_identifier (OSCTXT *pctxt, unsigned ident)
 {
    register int aal = 0, ll;
@@ -932,6 +1069,22 @@ int xe_objid (OSCTXT* pctxt, ASN1OBJID *pvalue, ASN1TagType tagging)
    return (aal);
 }
 
+int xe_encobjid
+(OSCTXT* pctxt, const ASN1EncOID *pvalue, ASN1TagType tagging)
+{
+   int aal;
+
+   if (0 == pvalue || 0 == pvalue->data || 0 == pvalue->numocts)
+      return LOG_RTERR(pctxt, RTERR_INVOBJID);
+
+   aal = xe_memcpy (pctxt, pvalue->data, pvalue->numocts);
+
+   if (tagging == ASN1EXPL && aal > 0)
+      aal = xe_tag_len (pctxt, TM_UNIV|TM_PRIM|ASN_ID_OBJID, aal);
+
+   return (aal);
+}
+
 int encodeRelOID (OSCTXT* pctxt, ASN1OBJID *pvalue, ASN1TagType tagging)
 {
    register int	aal, ll, i;
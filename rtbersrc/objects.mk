@@ -1,3 +1,8 @@
 RTBEROBJECTS = \
 $(OBJDIR)$(PS)decode$(OBJ) \
-$(OBJDIR)$(PS)encode$(OBJ)
+$(OBJDIR)$(PS)encode$(OBJ) \
+$(OBJDIR)$(PS)oidreg$(OBJ) \
+$(OBJDIR)$(PS)pardecode$(OBJ) \
+$(OBJDIR)$(PS)path$(OBJ) \
+$(OBJDIR)$(PS)pipeline$(OBJ) \
+$(OBJDIR)$(PS)validate$(OBJ)
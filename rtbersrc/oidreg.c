@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "asn1ber.h"
+
+/* Make room in the handler array for all OIDs in the table.  OIDs may  */
+/* also be added to the table directly, so the array can lag behind.    */
+
+static int growHandlers (ASN1OIDRegistry* pReg)
+{
+   OSCTXT* pctxt = pReg->oidTable.pctxt;
+   OSUINT32 capacity = pReg->capacity;
+   ASN1OIDHandler* handlers;
+
+   if (pReg->oidTable.count <= capacity) return 0;
+
+   while (capacity < pReg->oidTable.count)
+      capacity = (capacity == 0) ? 16 : capacity * 2;
+
+   handlers = (ASN1OIDHandler*) ((0 == pReg->handlers) ?
+      rtxMemAlloc (pctxt, capacity * sizeof(ASN1OIDHandler)) :
+      rtxMemRealloc (pctxt, pReg->handlers,
+                     capacity * sizeof(ASN1OIDHandler)));
+
+   if (0 == handlers) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+   memset (&handlers[pReg->capacity], 0,
+           (capacity - pReg->capacity) * sizeof(ASN1OIDHandler));
+
+   pReg->handlers = handlers;
+   pReg->capacity = capacity;
+
+   return 0;
+}
+
+static int setHandler
+(ASN1OIDRegistry* pReg, OSUINT32 handle, XD_ELEMDECFUNC decFunc,
+ size_t valueSize)
+{
+   int stat = growHandlers (pReg);
+   if (stat != 0) return LOG_RTERR (pReg->oidTable.pctxt, stat);
+
+   pReg->handlers[handle - 1].decFunc = decFunc;
+   pReg->handlers[handle - 1].valueSize = valueSize;
+
+   return 0;
+}
+
+int berOIDRegInit (OSCTXT* pctxt, ASN1OIDRegistry* pReg)
+{
+   int stat;
+
+   if (0 == pReg) return RTERR_NULLPTR;
+
+   pReg->handlers = 0;
+   pReg->capacity = 0;
+
+   stat = rtxOIDTableInit (pctxt, &pReg->oidTable);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   return 0;
+}
+
+void berOIDRegFree (ASN1OIDRegistry* pReg)
+{
+   if (0 == pReg || 0 == pReg->oidTable.pctxt) return;
+
+   rtxMemFreePtr (pReg->oidTable.pctxt, pReg->handlers);
+   pReg->handlers = 0;
+   pReg->capacity = 0;
+
+   rtxOIDTableFree (&pReg->oidTable);
+}
+
+int berOIDRegAdd
+(ASN1OIDRegistry* pReg, const OSOCTET* data, OSUINT32 numocts,
+ XD_ELEMDECFUNC decFunc, size_t valueSize)
+{
+   OSUINT32 handle;
+   int stat;
+
+   if (0 == pReg || 0 == decFunc) return RTERR_NULLPTR;
+   if (0 == valueSize)
+      return LOG_RTERR (pReg->oidTable.pctxt, RTERR_INVPARAM);
+
+   stat = rtxOIDTableAdd (&pReg->oidTable, data, numocts, &handle);
+   if (stat != 0) return LOG_RTERR (pReg->oidTable.pctxt, stat);
+
+   return setHandler (pReg, handle, decFunc, valueSize);
+}
+
+int berOIDRegAddObjId
+(ASN1OIDRegistry* pReg, const ASN1OBJID* pOID,
+ XD_ELEMDECFUNC decFunc, size_t valueSize)
+{
+   OSUINT32 handle;
+   int stat;
+
+   if (0 == pReg || 0 == decFunc) return RTERR_NULLPTR;
+   if (0 == valueSize)
+      return LOG_RTERR (pReg->oidTable.pctxt, RTERR_INVPARAM);
+
+   stat = rtxOIDTableAddObjId (&pReg->oidTable, pOID, &handle);
+   if (stat != 0) return LOG_RTERR (pReg->oidTable.pctxt, stat);
+
+   return setHandler (pReg, handle, decFunc, valueSize);
+}
+
+const ASN1OIDHandler* berOIDRegFind
+(const ASN1OIDRegistry* pReg, const ASN1EncOID* pOID)
+{
+   OSUINT32 handle;
+
+   if (0 == pReg || 0 == pOID) return 0;
+
+   handle = (pOID->handle != 0) ? pOID->handle :
+      rtxOIDTableFind (&pReg->oidTable, pOID->data, pOID->numocts);
+
+   if (handle == 0 || handle > pReg->capacity ||
+       0 == pReg->handlers[handle - 1].decFunc)
+      return 0;
+
+   return &pReg->handlers[handle - 1];
+}
+
+int xd_OpenTypeByOID
+(OSCTXT* pctxt, const ASN1OIDRegistry* pReg, const ASN1EncOID* pOID,
+ void** ppvalue, ASN1OpenType* pOpenType)
+{
+   const ASN1OIDHandler* pHandler = berOIDRegFind (pReg, pOID);
+   int stat;
+
+   if (0 == ppvalue) return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   *ppvalue = 0;
+
+   if (0 != pHandler) {
+      void* pvalue = rtxMemAllocZ (pctxt, pHandler->valueSize);
+      if (0 == pvalue) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+      stat = pHandler->decFunc (pctxt, pvalue, ASN1EXPL, 0);
+      if (stat != 0) {
+         rtxMemFreePtr (pctxt, pvalue);
+         return LOG_RTERR (pctxt, stat);
+      }
+
+      *ppvalue = pvalue;
+
+      if (0 != pOpenType) {
+         pOpenType->numocts = 0;
+         pOpenType->data = 0;
+      }
+   }
+   else if (0 != pOpenType) {
+      stat = xd_OpenType (pctxt, &pOpenType->data, &pOpenType->numocts);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+   else {
+      stat = xd_NextElement (pctxt);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+
+   return 0;
+}
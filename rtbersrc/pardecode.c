@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "asn1ber.h"
+#include "rtxsrc/rtxThread.h"
+
+/* Minimum number of elements decoded by each thread.  Below this, the */
+/* cost of starting a thread outweighs the work done in it.            */
+
+#ifndef XD_K_PARMINELEMS
+#define XD_K_PARMINELEMS 256
+#endif
+
+typedef struct {
+   OSCTXT          ctxt;        /* decode context for this partition    */
+   const size_t*   pOffsets;    /* start offset of each element         */
+   OSRTDListNode*  pFirstNode;  /* list node of first element           */
+   size_t          count;       /* number of elements                   */
+   size_t          endIndex;    /* offset following the last element    */
+   XD_ELEMDECFUNC  decFunc;     /* element decode function              */
+   int             status;      /* completion status                    */
+   OSRTThread      thread;      /* thread handle                        */
+   OSBOOL          started;     /* thread was started                   */
+} XDParTask;
+
+/* Decode count elements from their recorded offsets.  Each must end  */
+/* where the next one starts, the last one at endIndex.                 */
+
+static int decodeElems
+(OSCTXT* pctxt, const size_t* pOffsets, OSRTDListNode* pnode, size_t count,
+ size_t endIndex, XD_ELEMDECFUNC decFunc)
+{
+   size_t i;
+   int stat;
+
+   for (i = 0; i < count; i++, pnode = pnode->next) {
+      pctxt->buffer.byteIndex = pOffsets[i];
+      stat = decFunc (pctxt, pnode->data, ASN1EXPL, 0);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+      if (pctxt->buffer.byteIndex !=
+          ((i + 1 < count) ? pOffsets[i + 1] : endIndex))
+         return LOG_RTERR (pctxt, RTERR_BADVALUE);
+   }
+
+   return 0;
+}
+
+static void decodeTask (void* pArg)
+{
+   XDParTask* pTask = (XDParTask*) pArg;
+
+   pTask->status = decodeElems (&pTask->ctxt, pTask->pOffsets,
+      pTask->pFirstNode, pTask->count, pTask->endIndex, pTask->decFunc);
+}
+
+int xd_SeqOfElemsParallel
+(OSCTXT* pctxt, OSRTDList* pList, size_t elemSize, int length,
+ XD_ELEMDECFUNC decFunc, int numThreads)
+{
+   ASN1ElemOffsets offsets;
+   XDParTask*     pTasks;
+   OSRTDListNode* pnode;
+   size_t         count, start, i, j;
+   int            ntasks, stat;
+
+   if (numThreads <= 0) numThreads = rtxGetNumProcessors ();
+
+   if (numThreads <= 1) {
+      stat = xd_SeqOfElems (pctxt, pList, elemSize, length, decFunc);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+      return 0;
+   }
+
+   /* Scan contents, recording the start offset of each element */
+
+   stat = xd_ElemOffsets (pctxt, length, &offsets);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   count = offsets.count;
+   if (count == 0) return 0;
+
+   pnode = rtxDListAllocNodesAndData (pctxt, pList, count, elemSize);
+   if (0 == pnode) {
+      xd_FreeElemOffsets (pctxt, &offsets);
+      return LOG_RTERR (pctxt, RTERR_NOMEM);
+   }
+
+   ntasks = (int) ASN1MIN ((size_t)numThreads, count / XD_K_PARMINELEMS);
+
+   pTasks = (ntasks > 1) ? (XDParTask*)
+      rtxMemAllocZ (pctxt, ntasks * sizeof(XDParTask)) : 0;
+
+   if (0 == pTasks) {
+      /* Too few elements to be worth splitting; decode serially */
+      stat = decodeElems
+         (pctxt, offsets.pOffsets, pnode, count, offsets.endIndex, decFunc);
+   }
+   else {
+      /* Split the element range into contiguous partitions, each with */
+      /* its own context referencing the shared message buffer.        */
+
+      for (i = 0, start = 0; i < (size_t)ntasks; i++) {
+         XDParTask* pTask = &pTasks[i];
+
+         rtInitContext (&pTask->ctxt);
+         rtxInitContextBuffer
+            (&pTask->ctxt, pctxt->buffer.data, pctxt->buffer.size);
+         pTask->ctxt.flags = pctxt->flags;
+
+         pTask->count = (count / ntasks) + ((i < count % ntasks) ? 1 : 0);
+         pTask->pOffsets = &offsets.pOffsets[start];
+         pTask->pFirstNode = pnode;
+         pTask->decFunc = decFunc;
+
+         for (j = 0; j < pTask->count; j++) pnode = pnode->next;
+         start += pTask->count;
+
+         pTask->endIndex = (start < count) ?
+            offsets.pOffsets[start] : offsets.endIndex;
+      }
+
+      /* The calling thread decodes the first partition itself.  If a  */
+      /* thread cannot be started, its partition is decoded here too.  */
+
+      for (i = 1; i < (size_t)ntasks; i++) {
+         pTasks[i].started = (OSBOOL) (0 == rtxThreadCreate
+            (&pTasks[i].thread, decodeTask, &pTasks[i]));
+      }
+
+      decodeTask (&pTasks[0]);
+
+      for (i = 1; i < (size_t)ntasks; i++) {
+         if (pTasks[i].started) rtxThreadJoin (&pTasks[i].thread);
+         else decodeTask (&pTasks[i]);
+      }
+
+      /* Hand memory and the first error over to the caller's context */
+
+      for (i = 0; i < (size_t)ntasks; i++) {
+         XDParTask* pTask = &pTasks[i];
+
+         if (stat == 0 && pTask->status != 0) {
+            rtxErrFreeParms (pctxt);
+            pctxt->errInfo = pTask->ctxt.errInfo;
+            memset (&pTask->ctxt.errInfo, 0, sizeof(ASN1ErrInfo));
+            stat = pTask->status;
+         }
+
+         if (rtxMemHeapTransfer (pctxt, &pTask->ctxt) != 0 && stat == 0)
+            stat = RTERR_NOMEM;
+
+         rtFreeContext (&pTask->ctxt);
+      }
+
+      rtxMemFreePtr (pctxt, pTasks);
+   }
+
+   xd_FreeElemOffsets (pctxt, &offsets);
+
+   pctxt->buffer.byteIndex = offsets.endIndex;
+
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+   return 0;
+}
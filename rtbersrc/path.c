@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "asn1ber.h"
+
+/* Names of universal types that may be used in path expressions */
+
+static const struct {
+   const char* name;
+   ASN1TAG     tag;
+} pathTypeNames[] = {
+   { "BOOL",      TM_UNIV|TM_PRIM|ASN_ID_BOOL },
+   { "INT",       TM_UNIV|TM_PRIM|ASN_ID_INT },
+   { "BITSTR",    TM_UNIV|TM_PRIM|ASN_ID_BITSTR },
+   { "OCTSTR",    TM_UNIV|TM_PRIM|ASN_ID_OCTSTR },
+   { "NULL",      TM_UNIV|TM_PRIM|ASN_ID_NULL },
+   { "OID",       TM_UNIV|TM_PRIM|ASN_ID_OBJID },
+   { "REAL",      TM_UNIV|TM_PRIM|ASN_ID_REAL },
+   { "ENUM",      TM_UNIV|TM_PRIM|ASN_ID_ENUM },
+   { "UTF8",      TM_UNIV|TM_PRIM|ASN_ID_UTF8String },
+   { "RELOID",    TM_UNIV|TM_PRIM|ASN_ID_RELOID },
+   { "SEQ",       TM_UNIV|TM_CONS|ASN_ID_SEQ },
+   { "SET",       TM_UNIV|TM_CONS|ASN_ID_SET },
+   { "NUMERIC",   TM_UNIV|TM_PRIM|ASN_ID_NumericString },
+   { "PRINTABLE", TM_UNIV|TM_PRIM|ASN_ID_PrintableString },
+   { "T61",       TM_UNIV|TM_PRIM|ASN_ID_TeletexString },
+   { "IA5",       TM_UNIV|TM_PRIM|ASN_ID_IA5String },
+   { "UTCTIME",   TM_UNIV|TM_PRIM|ASN_ID_UTCTime },
+   { "GENTIME",   TM_UNIV|TM_PRIM|ASN_ID_GeneralTime },
+   { "VISIBLE",   TM_UNIV|TM_PRIM|ASN_ID_VisibleString },
+   { "UNIVSTR",   TM_UNIV|TM_PRIM|ASN_ID_UniversalString },
+   { "BMP",       TM_UNIV|TM_PRIM|ASN_ID_BMPString }
+} ;
+
+#define IS_DIGIT(c)  ((c) >= '0' && (c) <= '9')
+#define IS_UPPER(c)  ((c) >= 'A' && (c) <= 'Z')
+
+/* Parse a decimal number not exceeding maxValue */
+
+static const char* parseNumber
+(const char* p, OSUINT32 maxValue, OSUINT32* pvalue)
+{
+   OSUINT32 value = 0;
+
+   if (!IS_DIGIT (*p)) return 0;
+
+   do {
+      OSUINT32 digit = (OSUINT32)(*p++ - '0');
+      if (value > (maxValue - digit) / 10) return 0;
+      value = (value * 10) + digit;
+   } while (IS_DIGIT (*p));
+
+   *pvalue = value;
+   return p;
+}
+
+/* Parse a word of upper case letters and digits into a name buffer */
+
+static const char* parseName (const char* p, char* name, size_t bufsiz)
+{
+   size_t n = 0;
+
+   while (IS_UPPER (*p) || IS_DIGIT (*p)) {
+      if (n + 1 >= bufsiz) return 0;
+      name[n++] = *p++;
+   }
+   name[n] = '\0';
+
+   return (n > 0) ? p : 0;
+}
+
+/* Parse one tag specification: '*', a type name or a bracketed tag */
+
+static const char* parseTag (const char* p, ASN1TAG* ptag)
+{
+   char     name[16];
+   OSUINT32 idcode, i;
+   ASN1TAG  tclass = TM_CTXT;
+
+   if (*p == '*') {
+      *ptag = 0;
+      return p + 1;
+   }
+   else if (*p == '[') {
+      p++;
+      if (IS_UPPER (*p)) {
+         p = parseName (p, name, sizeof(name));
+         if (0 == p || *p++ != ' ') return 0;
+
+         if (0 == strcmp (name, "UNIVERSAL")) tclass = TM_UNIV;
+         else if (0 == strcmp (name, "APPLICATION")) tclass = TM_APPL;
+         else if (0 == strcmp (name, "PRIVATE")) tclass = TM_PRIV;
+         else return 0;
+      }
+      p = parseNumber (p, TM_IDCODE, &idcode);
+      if (0 == p || *p++ != ']') return 0;
+
+      /* [UNIVERSAL 0] is reserved for end-of-contents octets and is    */
+      /* used in compiled paths to match any tag.                       */
+      if (tclass == TM_UNIV && idcode == 0) return 0;
+
+      *ptag = tclass | idcode;
+      return p;
+   }
+   else {
+      p = parseName (p, name, sizeof(name));
+      if (0 == p) return 0;
+
+      for (i = 0; i < sizeof(pathTypeNames)/sizeof(pathTypeNames[0]); i++) {
+         if (0 == strcmp (name, pathTypeNames[i].name)) {
+            *ptag = pathTypeNames[i].tag;
+            return p;
+         }
+      }
+      return 0;
+   }
+}
+
+int berPathCompile
+(OSCTXT* pctxt, const char* expr, ASN1PathStep* pSteps, OSUINT32 maxSteps,
+ OSUINT32* pNumSteps)
+{
+   const char* p = expr;
+   OSUINT32 n = 0;
+
+   if (0 == expr || 0 == pSteps || 0 == pNumSteps)
+      return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   for (;;) {
+      if (n == maxSteps) return LOG_RTERR (pctxt, RTERR_TOOMANY);
+
+      p = parseTag (p, &pSteps[n].tag);
+      if (0 == p) return LOG_RTERR (pctxt, RTERR_INVFORMAT);
+
+      pSteps[n].index = 0;
+      if (*p == '[') {
+         p = parseNumber (p + 1, 0xFFFFFFFFu, &pSteps[n].index);
+         if (0 == p || *p++ != ']') return LOG_RTERR (pctxt, RTERR_INVFORMAT);
+      }
+      n++;
+
+      if (*p == '\0') break;
+      if (*p++ != '.') return LOG_RTERR (pctxt, RTERR_INVFORMAT);
+   }
+
+   *pNumSteps = n;
+   return 0;
+}
+
+int xd_FindPath
+(OSCTXT* pctxt, const ASN1PathStep* pSteps, OSUINT32 numSteps,
+ ASN1ElemSpan* pSpan)
+{
+   size_t   startIndex = pctxt->buffer.byteIndex;
+   size_t   endIndex = pctxt->buffer.size;  /* end of current level   */
+   size_t   elemIndex;
+   OSBOOL   indef = FALSE;                   /* current level is indef  */
+   OSUINT32 i, count;
+   ASN1TAG  tag;
+   int      len, stat = 0;
+
+   if (0 == pSteps || 0 == pSpan) return LOG_RTERR (pctxt, RTERR_NULLPTR);
+   if (numSteps == 0) return LOG_RTERR (pctxt, RTERR_INVPARAM);
+
+   for (i = 0; ; ) {
+      count = pSteps[i].index;
+
+      /* Skip over sibling elements until the requested occurrence of   */
+      /* the tag is found or the end of the current level is reached.   */
+
+      for (;;) {
+         elemIndex = pctxt->buffer.byteIndex;
+
+         if (indef) {
+            if (elemIndex + 2 <= pctxt->buffer.size &&
+                pctxt->buffer.data[elemIndex] == 0 &&
+                pctxt->buffer.data[elemIndex + 1] == 0)
+               stat = RTERR_IDNOTFOU;
+         }
+         else if (elemIndex >= endIndex) stat = RTERR_IDNOTFOU;
+         if (stat != 0) break;
+
+         stat = xd_tag_len (pctxt, &tag, &len, XM_ADVANCE);
+         if (stat != 0) break;
+
+         if ((pSteps[i].tag == 0 ||
+              (tag & ~TM_CONS) == (pSteps[i].tag & ~TM_CONS)) &&
+             count-- == 0)
+            break;
+
+         if (len == ASN_K_INDEFLEN) {
+            pctxt->buffer.byteIndex = elemIndex;
+            stat = xd_NextElement (pctxt);
+            if (stat != 0) break;
+         }
+         else pctxt->buffer.byteIndex += len;
+      }
+      if (stat != 0) break;
+
+      if (++i == numSteps) break;
+
+      /* Descend into the contents of the matched element */
+
+      if (0 == (tag & TM_CONS)) {
+         stat = RTERR_IDNOTFOU;
+         break;
+      }
+      indef = (OSBOOL)(len == ASN_K_INDEFLEN);
+      if (!indef) endIndex = pctxt->buffer.byteIndex + len;
+   }
+
+   if (stat != 0) {
+      pctxt->buffer.byteIndex = startIndex;
+      return LOG_RTERR (pctxt, stat);
+   }
+
+   /* Return the contents of the element found and leave the decode    */
+   /* position at its identifier octets.                               */
+
+   pSpan->tag = tag;
+   pSpan->data = OSRTBUFPTR (pctxt);
+
+   if (len == ASN_K_INDEFLEN) {
+      pctxt->buffer.byteIndex = elemIndex;
+      stat = xd_NextElement (pctxt);
+      if (stat != 0) {
+         pctxt->buffer.byteIndex = startIndex;
+         return LOG_RTERR (pctxt, stat);
+      }
+      pSpan->numocts = (size_t)(OSRTBUFPTR (pctxt) - pSpan->data) - 2;
+   }
+   else pSpan->numocts = (size_t)len;
+
+   pctxt->buffer.byteIndex = elemIndex;
+
+   return 0;
+}
@@ -0,0 +1,527 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asn1berPipeline.h"
+#include "rtxsrc/rtxThread.h"
+
+/* Default number of in-flight records per worker thread */
+
+#ifndef BER_K_PLRECSPERTHREAD
+#define BER_K_PLRECSPERTHREAD 32
+#endif
+
+/* Initial size of the buffer used to read a file */
+
+#ifndef BER_K_PLREADCHUNK
+#define BER_K_PLREADCHUNK 65536
+#endif
+
+/* Record location as queued for a worker, with the context it is to    */
+/* be decoded on.                                                       */
+
+typedef struct {
+   OSSIZE   recnum;
+   size_t   offset;
+   size_t   length;
+   OSCTXT*  pctxt;
+} BerPLRecord;
+
+/* Per-worker record queue, with its own lock.  The owner takes records */
+/* from the head and other workers steal from the tail, so the pipeline */
+/* mutex is not needed to take work.                                    */
+
+typedef struct {
+   OSRTMutex    mutex;
+   BerPLRecord* items;
+   size_t       head;
+   size_t       count;
+} BerPLQueue;
+
+/* Decoded record awaiting delivery in ordered mode.  Records retire in */
+/* order, so slot recnum % window cannot be reused while occupied.      */
+
+typedef struct {
+   OSCTXT*  pctxt;
+   void*    pvalue;
+   int      status;
+   OSBOOL   complete;
+} BerPLSlot;
+
+typedef struct {
+   ASN1BerPipeline* pPipeline;
+   int              index;
+   OSSIZE           steals;       /* records stolen, not yet in stats  */
+   OSRTThread       thread;
+   OSBOOL           started;
+} BerPLWorker;
+
+struct ASN1BerPipeline {
+   ASN1BerPipelineConfig config;
+   int              numWorkers;
+   int              numQueueMutexes;  /* queue mutexes initialized     */
+   size_t           window;       /* max in-flight records             */
+   OSRTMutex        mutex;        /* guards all but the queues         */
+   OSRTCondVar      workCond;     /* record queued or reader finished  */
+   OSRTCondVar      spaceCond;    /* in-flight record retired          */
+   BerPLWorker*     workers;
+   BerPLQueue*      queues;
+   BerPLSlot*       slots;
+   OSCTXT*          contexts;     /* one context per in-flight record  */
+   OSCTXT**         pool;         /* free contexts                     */
+   size_t           poolCount;
+   const OSOCTET*   data;         /* buffer of current run             */
+   OSSIZE           dispatched;   /* records handed to workers         */
+   OSSIZE           retired;      /* records delivered and released    */
+   OSSIZE           nextDeliver;  /* next record to deliver (ordered)  */
+   OSBOOL           readerDone;
+   OSBOOL           delivering;
+   ASN1BerPipelineStats stats;
+};
+
+/* Take the next record for the given worker, stealing from the tail    */
+/* of another worker's queue if its own is empty.  Only the queue       */
+/* mutexes are locked; the pipeline mutex may or may not be held.       */
+
+static OSBOOL takeRecord (BerPLWorker* pWorker, BerPLRecord* pRecord)
+{
+   ASN1BerPipeline* pPipeline = pWorker->pPipeline;
+   BerPLQueue* pQueue = &pPipeline->queues[pWorker->index];
+   OSBOOL found = FALSE;
+   int i;
+
+   rtxMutexLock (&pQueue->mutex);
+   if (pQueue->count > 0) {
+      *pRecord = pQueue->items[pQueue->head];
+      pQueue->head = (pQueue->head + 1) % pPipeline->window;
+      pQueue->count--;
+      found = TRUE;
+   }
+   rtxMutexUnlock (&pQueue->mutex);
+
+   for (i = 1; !found && i < pPipeline->numWorkers; i++) {
+      pQueue = &pPipeline->queues
+         [(pWorker->index + i) % pPipeline->numWorkers];
+
+      rtxMutexLock (&pQueue->mutex);
+      if (pQueue->count > 0) {
+         pQueue->count--;
+         *pRecord = pQueue->items
+            [(pQueue->head + pQueue->count) % pPipeline->window];
+         pWorker->steals++;
+         found = TRUE;
+      }
+      rtxMutexUnlock (&pQueue->mutex);
+   }
+
+   return found;
+}
+
+/* Reset a record context and return it to the pool.  Must be called    */
+/* with the pipeline mutex held.                                        */
+
+static void releaseContext (ASN1BerPipeline* pPipeline, OSCTXT* pctxt)
+{
+   rtxErrReset (pctxt);
+   rtxMemReset (pctxt);
+
+   pPipeline->pool[pPipeline->poolCount++] = pctxt;
+   pPipeline->retired++;
+
+   rtxCondVarSignal (&pPipeline->spaceCond);
+}
+
+/* Deliver completed records in order, starting with the next one due.  */
+/* Must be called with the pipeline mutex held; it is released while    */
+/* the completion function runs.                                        */
+
+static void deliverOrdered (ASN1BerPipeline* pPipeline)
+{
+   BerPLSlot slot, *pSlot;
+   OSSIZE recnum;
+
+   pPipeline->delivering = TRUE;
+
+   for (;;) {
+      recnum = pPipeline->nextDeliver;
+      pSlot = &pPipeline->slots[recnum % pPipeline->window];
+      if (!pSlot->complete) break;
+
+      slot = *pSlot;
+      pSlot->complete = FALSE;
+
+      rtxMutexUnlock (&pPipeline->mutex);
+
+      pPipeline->config.doneFunc (pPipeline->config.pCbArg,
+         slot.pctxt, slot.pvalue, recnum, slot.status);
+
+      rtxMutexLock (&pPipeline->mutex);
+
+      pPipeline->nextDeliver++;
+      releaseContext (pPipeline, slot.pctxt);
+   }
+
+   pPipeline->delivering = FALSE;
+}
+
+static void pipelineWorker (void* pArg)
+{
+   BerPLWorker* pWorker = (BerPLWorker*) pArg;
+   ASN1BerPipeline* pPipeline = pWorker->pPipeline;
+   BerPLRecord record;
+   OSCTXT* pctxt;
+   void* pvalue;
+   int stat;
+
+   for (;;) {
+
+      /* Records are queued with the pipeline mutex held, so a worker   */
+      /* that finds no work while holding it cannot miss the signal.    */
+
+      if (!takeRecord (pWorker, &record)) {
+         OSBOOL found;
+
+         rtxMutexLock (&pPipeline->mutex);
+         while (!(found = takeRecord (pWorker, &record)) &&
+                !pPipeline->readerDone) {
+            rtxCondVarWait (&pPipeline->workCond, &pPipeline->mutex);
+         }
+         rtxMutexUnlock (&pPipeline->mutex);
+
+         if (!found) break;
+      }
+
+      pctxt = record.pctxt;
+      pvalue = 0;
+      stat = xd_setp (pctxt, pPipeline->data + record.offset,
+                      (int)record.length, 0, 0);
+
+      if (stat == 0 && pPipeline->config.valueSize > 0) {
+         pvalue = rtxMemAllocZ (pctxt, pPipeline->config.valueSize);
+         if (0 == pvalue) stat = LOG_RTERR (pctxt, RTERR_NOMEM);
+      }
+      if (stat == 0) {
+         stat = pPipeline->config.decFunc (pctxt, pvalue, ASN1EXPL, 0);
+      }
+
+      rtxMutexLock (&pPipeline->mutex);
+
+      if (stat == 0) pPipeline->stats.records++;
+      else pPipeline->stats.errors++;
+      pPipeline->stats.bytes += record.length;
+      pPipeline->stats.steals += pWorker->steals;
+      pWorker->steals = 0;
+
+      if (pPipeline->config.ordered) {
+         BerPLSlot* pSlot =
+            &pPipeline->slots[record.recnum % pPipeline->window];
+
+         pSlot->pctxt = pctxt;
+         pSlot->pvalue = pvalue;
+         pSlot->status = stat;
+         pSlot->complete = TRUE;
+
+         if (!pPipeline->delivering &&
+             record.recnum == pPipeline->nextDeliver) {
+            deliverOrdered (pPipeline);
+         }
+      }
+      else {
+         rtxMutexUnlock (&pPipeline->mutex);
+
+         pPipeline->config.doneFunc (pPipeline->config.pCbArg,
+            pctxt, pvalue, record.recnum, stat);
+
+         rtxMutexLock (&pPipeline->mutex);
+
+         releaseContext (pPipeline, pctxt);
+      }
+
+      rtxMutexUnlock (&pPipeline->mutex);
+   }
+}
+
+int berPipelineCreate
+(ASN1BerPipeline** ppPipeline, const ASN1BerPipelineConfig* pConfig)
+{
+   ASN1BerPipeline* pPipeline;
+   size_t i;
+   int stat = 0;
+
+   if (0 == ppPipeline || 0 == pConfig || 0 == pConfig->decFunc ||
+       0 == pConfig->doneFunc)
+      return RTERR_NULLPTR;
+
+   *ppPipeline = 0;
+
+   pPipeline = (ASN1BerPipeline*) malloc (sizeof(ASN1BerPipeline));
+   if (0 == pPipeline) return RTERR_NOMEM;
+
+   memset (pPipeline, 0, sizeof(ASN1BerPipeline));
+   pPipeline->config = *pConfig;
+
+   pPipeline->numWorkers = (pConfig->numThreads > 0) ?
+      pConfig->numThreads : rtxGetNumProcessors ();
+
+   pPipeline->window = (pConfig->maxInFlight > 0) ? pConfig->maxInFlight :
+      (size_t)pPipeline->numWorkers * BER_K_PLRECSPERTHREAD;
+
+   pPipeline->workers = (BerPLWorker*)
+      calloc (pPipeline->numWorkers, sizeof(BerPLWorker));
+   pPipeline->queues = (BerPLQueue*)
+      calloc (pPipeline->numWorkers, sizeof(BerPLQueue));
+   pPipeline->slots = (BerPLSlot*)
+      calloc (pPipeline->window, sizeof(BerPLSlot));
+   pPipeline->contexts = (OSCTXT*)
+      calloc (pPipeline->window, sizeof(OSCTXT));
+   pPipeline->pool = (OSCTXT**)
+      calloc (pPipeline->window, sizeof(OSCTXT*));
+
+   if (0 == pPipeline->workers || 0 == pPipeline->queues ||
+       0 == pPipeline->slots || 0 == pPipeline->contexts ||
+       0 == pPipeline->pool) stat = RTERR_NOMEM;
+
+   for (i = 0; stat == 0 && i < (size_t)pPipeline->numWorkers; i++) {
+      pPipeline->workers[i].pPipeline = pPipeline;
+      pPipeline->workers[i].index = (int)i;
+      pPipeline->queues[i].items = (BerPLRecord*)
+         malloc (pPipeline->window * sizeof(BerPLRecord));
+      if (0 == pPipeline->queues[i].items) stat = RTERR_NOMEM;
+      else stat = rtxMutexInit (&pPipeline->queues[i].mutex);
+      if (stat == 0) pPipeline->numQueueMutexes++;
+   }
+
+   if (stat == 0) {
+      for (i = 0; i < pPipeline->window; i++) {
+         rtInitContext (&pPipeline->contexts[i]);
+      }
+      stat = rtxMutexInit (&pPipeline->mutex);
+   }
+   if (stat == 0) {
+      stat = rtxCondVarInit (&pPipeline->workCond);
+      if (stat != 0) rtxMutexFree (&pPipeline->mutex);
+   }
+   if (stat == 0) {
+      stat = rtxCondVarInit (&pPipeline->spaceCond);
+      if (stat != 0) {
+         rtxCondVarFree (&pPipeline->workCond);
+         rtxMutexFree (&pPipeline->mutex);
+      }
+   }
+
+   if (stat != 0) {
+      if (0 != pPipeline->queues) {
+         for (i = 0; i < (size_t)pPipeline->numWorkers; i++)
+            free (pPipeline->queues[i].items);
+         for (i = 0; i < (size_t)pPipeline->numQueueMutexes; i++)
+            rtxMutexFree (&pPipeline->queues[i].mutex);
+      }
+      free (pPipeline->workers);
+      free (pPipeline->queues);
+      free (pPipeline->slots);
+      free (pPipeline->contexts);
+      free (pPipeline->pool);
+      free (pPipeline);
+      return stat;
+   }
+
+   *ppPipeline = pPipeline;
+
+   return 0;
+}
+
+int berPipelineRunBuffer
+(ASN1BerPipeline* pPipeline, const OSOCTET* data, size_t size)
+{
+   OSCTXT ctxt;
+   BerPLQueue* pQueue;
+   BerPLRecord* pItem;
+   size_t i, start;
+   int nstarted = 0, stat = 0;
+
+   if (0 == pPipeline || (0 == data && size > 0)) return RTERR_NULLPTR;
+
+   /* Reset run state */
+
+   pPipeline->data = data;
+   pPipeline->dispatched = pPipeline->retired = pPipeline->nextDeliver = 0;
+   pPipeline->readerDone = pPipeline->delivering = FALSE;
+   memset (&pPipeline->stats, 0, sizeof(ASN1BerPipelineStats));
+
+   for (i = 0; i < pPipeline->window; i++) {
+      pPipeline->pool[i] = &pPipeline->contexts[i];
+      pPipeline->slots[i].complete = FALSE;
+   }
+   pPipeline->poolCount = pPipeline->window;
+
+   for (i = 0; i < (size_t)pPipeline->numWorkers; i++) {
+      pPipeline->queues[i].head = pPipeline->queues[i].count = 0;
+      pPipeline->workers[i].steals = 0;
+   }
+
+   for (i = 0; i < (size_t)pPipeline->numWorkers; i++) {
+      pPipeline->workers[i].started = (OSBOOL)(0 == rtxThreadCreate
+         (&pPipeline->workers[i].thread, pipelineWorker,
+          &pPipeline->workers[i]));
+      if (pPipeline->workers[i].started) nstarted++;
+   }
+
+   /* Split the input into top-level records and dispatch them, each    */
+   /* with a free context; the in-flight limit guarantees there is one. */
+   /* Queues of workers that could not be started are drained by        */
+   /* stealing.                                                         */
+
+   if (nstarted > 0) {
+      rtInitContext (&ctxt);
+      rtxInitContextBuffer (&ctxt, data, size);
+
+      while (ctxt.buffer.byteIndex < size) {
+         start = ctxt.buffer.byteIndex;
+
+         stat = xd_NextElement (&ctxt);
+         if (stat == 0 && ctxt.buffer.byteIndex > size) {
+            stat = LOG_RTERR (&ctxt, RTERR_ENDOFBUF);
+         }
+         if (stat != 0) break;
+
+         rtxMutexLock (&pPipeline->mutex);
+
+         while (pPipeline->dispatched - pPipeline->retired >=
+                pPipeline->window) {
+            rtxCondVarWait (&pPipeline->spaceCond, &pPipeline->mutex);
+         }
+
+         pQueue = &pPipeline->queues
+            [pPipeline->dispatched % pPipeline->numWorkers];
+
+         rtxMutexLock (&pQueue->mutex);
+
+         pItem = &pQueue->items
+            [(pQueue->head + pQueue->count) % pPipeline->window];
+
+         pItem->recnum = pPipeline->dispatched++;
+         pItem->offset = start;
+         pItem->length = ctxt.buffer.byteIndex - start;
+         pItem->pctxt = pPipeline->pool[--pPipeline->poolCount];
+         pQueue->count++;
+
+         rtxMutexUnlock (&pQueue->mutex);
+
+         rtxCondVarSignal (&pPipeline->workCond);
+         rtxMutexUnlock (&pPipeline->mutex);
+      }
+
+      rtFreeContext (&ctxt);
+   }
+   else stat = RTERR_NOMEM;
+
+   rtxMutexLock (&pPipeline->mutex);
+   pPipeline->readerDone = TRUE;
+   rtxCondVarBroadcast (&pPipeline->workCond);
+   rtxMutexUnlock (&pPipeline->mutex);
+
+   for (i = 0; i < (size_t)pPipeline->numWorkers; i++) {
+      if (pPipeline->workers[i].started) {
+         rtxThreadJoin (&pPipeline->workers[i].thread);
+         pPipeline->workers[i].started = FALSE;
+      }
+   }
+
+   return stat;
+}
+
+int berPipelineRunFile (ASN1BerPipeline* pPipeline, const char* filename)
+{
+   FILE* fp;
+   OSOCTET* data = 0;
+   OSOCTET* newData;
+   size_t size = 0, bufsiz = 0, n;
+   int stat = 0;
+
+   if (0 == pPipeline || 0 == filename) return RTERR_NULLPTR;
+
+   fp = fopen (filename, "rb");
+   if (0 == fp) return RTERR_FILNOTFOU;
+
+   /* Read in chunks, doubling the buffer as needed, so that the size   */
+   /* is not limited by the range of ftell.                             */
+
+   for (;;) {
+      if (size == bufsiz) {
+         bufsiz = (bufsiz == 0) ? BER_K_PLREADCHUNK : bufsiz * 2;
+         if (bufsiz <= size) { stat = RTERR_NOMEM; break; }
+
+         newData = (OSOCTET*) realloc (data, bufsiz);
+         if (0 == newData) { stat = RTERR_NOMEM; break; }
+         data = newData;
+      }
+
+      n = fread (data + size, 1, bufsiz - size, fp);
+      size += n;
+
+      if (n == 0) {
+         if (ferror (fp)) stat = RTERR_READERR;
+         break;
+      }
+   }
+
+   fclose (fp);
+
+   if (stat == 0 && size > 0) {
+      stat = berPipelineRunBuffer (pPipeline, data, size);
+   }
+
+   free (data);
+
+   return stat;
+}
+
+void berPipelineGetStats
+(ASN1BerPipeline* pPipeline, ASN1BerPipelineStats* pStats)
+{
+   rtxMutexLock (&pPipeline->mutex);
+   *pStats = pPipeline->stats;
+   rtxMutexUnlock (&pPipeline->mutex);
+}
+
+void berPipelineFree (ASN1BerPipeline* pPipeline)
+{
+   size_t i;
+
+   if (0 == pPipeline) return;
+
+   for (i = 0; i < pPipeline->window; i++) {
+      rtFreeContext (&pPipeline->contexts[i]);
+   }
+   for (i = 0; i < (size_t)pPipeline->numWorkers; i++) {
+      free (pPipeline->queues[i].items);
+      rtxMutexFree (&pPipeline->queues[i].mutex);
+   }
+
+   rtxCondVarFree (&pPipeline->spaceCond);
+   rtxCondVarFree (&pPipeline->workCond);
+   rtxMutexFree (&pPipeline->mutex);
+
+   free (pPipeline->workers);
+   free (pPipeline->queues);
+   free (pPipeline->slots);
+   free (pPipeline->contexts);
+   free (pPipeline->pool);
+   free (pPipeline);
+}
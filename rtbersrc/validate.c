@@ -0,0 +1,323 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include "asn1ber.h"
+
+/* Maximum nesting level of constructed values checked by xd_Validate */
+
+#ifndef XD_K_MAXVALDEPTH
+#define XD_K_MAXVALDEPTH 64
+#endif
+
+/* One open constructed value on the validation stack */
+
+typedef struct {
+   size_t       start;          /* offset of identifier octets          */
+   size_t       limit;          /* end of contents, or of the enclosing
+                                   definite length value if indefinite  */
+   ASN1TAG      tag;            /* class and ID code of this value      */
+   ASN1TAG      prevTag;        /* tag of previous component of a SET   */
+   size_t       prevStart;      /* encoding of previous component       */
+   size_t       prevEnd;
+   OSBOOL       indef;          /* indefinite length                    */
+   OSBOOL       isSet;          /* DER SET: check component order       */
+   OSBOOL       hasPrev;        /* prevTag is valid                     */
+} XDValLevel;
+
+/* Parsed identifier and length octets */
+
+typedef struct {
+   OSOCTET      id;             /* first identifier octet               */
+   ASN1TAG      tag;            /* class and ID code, form bit clear    */
+   OSBOOL       highTag;        /* ID code >= 31                        */
+   OSBOOL       indef;          /* indefinite length                    */
+   size_t       len;            /* contents length if definite          */
+} XDValHeader;
+
+static int parseHeader
+(const OSOCTET* data, size_t limit, size_t* pidx, XDValHeader* pHdr,
+ OSBOOL der)
+{
+   size_t   i = *pidx, n;
+   OSUINT32 idcode;
+   OSOCTET  b;
+
+   if (i >= limit) return RTERR_ENDOFBUF;
+
+   b = pHdr->id = data[i++];
+   pHdr->highTag = (OSBOOL)((b & TM_B_IDCODE) == 31);
+
+   if (pHdr->highTag) {
+      /* ID code must be minimally encoded, fit in an ASN1TAG and not   */
+      /* be one that fits in the first octet.                           */
+      if (i >= limit) return RTERR_ENDOFBUF;
+      if (data[i] == 0x80) return RTERR_BADTAG;
+      idcode = 0; n = 0;
+      do {
+         if (i >= limit) return RTERR_ENDOFBUF;
+         b = data[i++];
+         idcode = (idcode * 128) + (b & 0x7F);
+         if (++n > 4 || idcode > TM_IDCODE) return RTERR_BADTAG;
+      } while (b & 0x80);
+      if (idcode < 31) return RTERR_BADTAG;
+   }
+   else idcode = b & TM_B_IDCODE;
+
+   pHdr->tag = ((ASN1TAG)(pHdr->id & TM_CLASS) << 24) | idcode;
+
+   if (i >= limit) return RTERR_ENDOFBUF;
+   b = data[i++];
+
+   pHdr->indef = FALSE;
+
+   if (b < 0x80) {
+      pHdr->len = b;
+   }
+   else if (b == 0x80) {
+      if (der || !(pHdr->id & TM_FORM)) return RTERR_INVLEN;
+      pHdr->indef = TRUE;
+      pHdr->len = 0;
+   }
+   else {
+      n = b & 0x7F;
+      if (n > 4) return RTERR_INVLEN;
+      if (n > limit - i) return RTERR_ENDOFBUF;
+
+      /* DER requires the short form below 128 and no leading zeros */
+      if (der && data[i] == 0) return RTERR_INVLEN;
+
+      for (pHdr->len = 0; n > 0; n--) {
+         pHdr->len = (pHdr->len * 256) + data[i++];
+      }
+      if (der && pHdr->len < 128) return RTERR_INVLEN;
+   }
+
+   if (!pHdr->indef && pHdr->len > limit - i) return RTERR_INVLEN;
+
+   *pidx = i;
+   return 0;
+}
+
+/* Compare two encodings as octet strings, the shorter one padded with */
+/* trailing zero octets (X.690 11.6).                                   */
+
+static int compareSetOfElems
+(const OSOCTET* data, size_t start1, size_t end1, size_t start2, size_t end2)
+{
+   size_t len1 = end1 - start1, len2 = end2 - start2, i;
+   OSOCTET b1, b2;
+
+   for (i = 0; i < len1 || i < len2; i++) {
+      b1 = (i < len1) ? data[start1 + i] : 0;
+      b2 = (i < len2) ? data[start2 + i] : 0;
+      if (b1 != b2) return (b1 < b2) ? -1 : 1;
+   }
+
+   return 0;
+}
+
+/* Checks on the form of universal types */
+
+static int checkForm (const XDValHeader* pHdr, OSBOOL der)
+{
+   OSOCTET idcode = (OSOCTET)(pHdr->id & TM_B_IDCODE);
+
+   if ((pHdr->id & TM_CLASS) != 0 || pHdr->highTag) return 0;
+
+   if (pHdr->id & TM_FORM) {
+      switch (idcode) {
+      case 0:                   /* reserved for EOC */
+      case ASN_ID_BOOL:
+      case ASN_ID_INT:
+      case ASN_ID_NULL:
+      case ASN_ID_OBJID:
+      case ASN_ID_REAL:
+      case ASN_ID_ENUM:
+      case ASN_ID_RELOID:
+         return RTERR_BADTAG;
+
+      case ASN_ID_EXTERN:
+      case ASN_ID_EPDV:
+      case ASN_ID_SEQ:
+      case ASN_ID_SET:
+      case 29:                  /* CHARACTER STRING */
+         return 0;
+
+      default:
+         /* DER does not allow constructed string encodings */
+         return (der) ? RTERR_BADTAG : 0;
+      }
+   }
+   else if (idcode == ASN_ID_SEQ || idcode == ASN_ID_SET) {
+      return RTERR_BADTAG;
+   }
+
+   return 0;
+}
+
+/* Checks on the contents of universal primitive types */
+
+static int checkPrimitive
+(const XDValHeader* pHdr, const OSOCTET* pContents, OSBOOL der)
+{
+   size_t len = pHdr->len, i;
+
+   if ((pHdr->id & TM_CLASS) != 0 || pHdr->highTag) return 0;
+
+   switch (pHdr->id & TM_B_IDCODE) {
+   case ASN_ID_BOOL:
+      if (len != 1) return RTERR_INVLEN;
+      if (der && pContents[0] != 0 && pContents[0] != 0xFF)
+         return RTERR_BADVALUE;
+      break;
+
+   case ASN_ID_INT:
+   case ASN_ID_ENUM:
+      if (len == 0) return RTERR_INVLEN;
+      if (der && len > 1 &&
+          ((pContents[0] == 0 && !(pContents[1] & 0x80)) ||
+           (pContents[0] == 0xFF && (pContents[1] & 0x80))))
+         return RTERR_BADVALUE;
+      break;
+
+   case ASN_ID_BITSTR:
+      if (len == 0 || pContents[0] > 7) return RTERR_INVLEN;
+      if (len == 1 && pContents[0] != 0) return RTERR_INVLEN;
+      if (der && len > 1 &&
+          (pContents[len - 1] & ((1 << pContents[0]) - 1)) != 0)
+         return RTERR_BADVALUE;
+      break;
+
+   case ASN_ID_NULL:
+      if (len != 0) return RTERR_INVLEN;
+      break;
+
+   case ASN_ID_OBJID:
+   case ASN_ID_RELOID:
+      if (len == 0 || (pContents[len - 1] & 0x80)) return RTERR_INVOBJID;
+      if (der) {
+         for (i = 0; i < len; i++) {
+            if (pContents[i] == 0x80 && (i == 0 || !(pContents[i-1] & 0x80)))
+               return RTERR_INVOBJID;
+         }
+      }
+      break;
+   }
+
+   return 0;
+}
+
+int xd_Validate (OSCTXT* pctxt, OSUINT32 flags)
+{
+   XDValLevel   stack[XD_K_MAXVALDEPTH];
+   XDValLevel*  pTop;
+   XDValHeader  hdr;
+   ASN1TAG      tag = 0;
+   const OSOCTET* data = pctxt->buffer.data;
+   size_t       size = pctxt->buffer.size;
+   size_t       idx = pctxt->buffer.byteIndex, start = idx, limit;
+   OSBOOL       der = (OSBOOL)((flags & XV_DER) != 0);
+   int          depth = 0, stat = 0;
+
+   for (;;) {
+      pTop = (depth > 0) ? &stack[depth - 1] : 0;
+
+      if (0 != pTop && !pTop->indef && idx == pTop->limit) {
+         /* End of definite length contents */
+         tag = pTop->tag;
+         start = pTop->start;
+         depth--;
+      }
+      else {
+         limit = (0 != pTop) ? pTop->limit : size;
+         start = idx;
+
+         stat = parseHeader (data, limit, &idx, &hdr, der);
+         if (stat != 0) break;
+
+         if (hdr.id == 0 && !hdr.indef) {
+            /* End-of-contents octets end the innermost value, which    */
+            /* must be of indefinite length.                            */
+            if (hdr.len != 0 || 0 == pTop || !pTop->indef) {
+               stat = RTERR_BADTAG;
+               break;
+            }
+            tag = pTop->tag;
+            start = pTop->start;
+            depth--;
+         }
+         else {
+            stat = checkForm (&hdr, der);
+            if (stat != 0) break;
+
+            if (hdr.id & TM_FORM) {
+               if (depth == XD_K_MAXVALDEPTH) {
+                  stat = RTERR_TOODEEP;
+                  break;
+               }
+
+               pTop = &stack[depth++];
+               pTop->start = start;
+               pTop->tag = hdr.tag;
+               pTop->limit = (hdr.indef) ? limit : idx + hdr.len;
+               pTop->indef = hdr.indef;
+               pTop->isSet = (OSBOOL)(der && hdr.id == (TM_FORM|ASN_ID_SET));
+               pTop->hasPrev = FALSE;
+               continue;
+            }
+
+            stat = checkPrimitive (&hdr, &data[idx], der);
+            if (stat != 0) break;
+
+            tag = hdr.tag;
+            idx += hdr.len;
+         }
+      }
+
+      /* A complete value with the given tag now occupies [start, idx) */
+
+      if (depth == 0) break;
+
+      /* The components of a DER SET must be in ascending tag order      */
+      /* (X.690 10.3).  The components of a SET have distinct tags, so   */
+      /* components with equal tags belong to a SET OF, whose encodings  */
+      /* must be in ascending order as octet strings (X.690 11.6).       */
+
+      pTop = &stack[depth - 1];
+      if (pTop->isSet) {
+         if (pTop->hasPrev &&
+             (tag < pTop->prevTag ||
+              (tag == pTop->prevTag && compareSetOfElems
+               (data, pTop->prevStart, pTop->prevEnd, start, idx) > 0))) {
+            stat = RTERR_SEQORDER;
+            break;
+         }
+         pTop->prevTag = tag;
+         pTop->prevStart = start;
+         pTop->prevEnd = idx;
+         pTop->hasPrev = TRUE;
+      }
+   }
+
+   if (stat != 0) {
+      pctxt->buffer.byteIndex = start;
+      return LOG_RTERR (pctxt, stat);
+   }
+
+   pctxt->buffer.byteIndex = idx;
+   return 0;
+}
@@ -14,13 +14,122 @@
  * maintain this copyright notice.
  *
  *****************************************************************************/
+/**
+ * @file rtBCD.h  Conversions between character strings and packed BCD or
+ * TBCD octet strings, as used for telephony identifiers such as IMSI,
+ * MSISDN and IMEI.
+ */
 #ifndef _RTBCD_H_
 #define _RTBCD_H_
 
-/* This file is only a placeholder to allow generated code to compile.
-   String to BCD conversions are not supported in the open source version.
-*/
+#include "rtxsrc/rtxCommon.h"
 
+#ifdef __cplusplus
+extern "C" {
 #endif
 
+/**
+ * @defgroup rtBCD BCD/TBCD string conversion functions
+ * @{
+ *
+ * Each octet holds two digits. In BCD the first digit is in the high
+ * nibble; in TBCD (3GPP TS 29.002) it is in the low nibble. The nibble
+ * values 0-9 are the digits '0'-'9' and 10-14 are the characters '*', '#',
+ * 'a', 'b' and 'c'. The value 15 is a filler: a string with an odd number
+ * of digits is completed with a filler nibble.
+ */
+#define RTBCD_TBCD      0x01    /* TBCD nibble order                    */
+#define RTBCD_FILLPAD   0x02    /* fill octets may follow the digits    */
+
+/**
+ * This function converts a BCD or TBCD octet string to a character
+ * string. Without the RTBCD_FILLPAD flag a filler is only accepted as the
+ * last nibble. With it, the digits end at the first filler and all
+ * following nibbles must also be fillers, as in fixed-size fields padded
+ * with 0xFF octets.
+ *
+ * @param data         Octets to be converted.
+ * @param numocts      Number of octets.
+ * @param buffer       Buffer to receive the null-terminated string.
+ * @param bufsiz       Size of the buffer; must be at least 2 * numocts + 1.
+ * @param flags        RTBCD_TBCD and/or RTBCD_FILLPAD, or 0.
+ * @return             Number of characters in the string, or a negative
+ *                       status value if an error occurred.
+ */
+EXTERNRT int rtBCDDecode
+(const OSOCTET* data, OSSIZE numocts, char* buffer, OSSIZE bufsiz,
+ OSUINT32 flags);
+
+/**
+ * This function converts a character string to a BCD or TBCD octet
+ * string. With the RTBCD_FILLPAD flag the rest of the buffer is filled
+ * with 0xFF octets.
+ *
+ * @param str          Null-terminated string of digits to be converted.
+ * @param buffer       Buffer to receive the octets.
+ * @param bufsiz       Size of the buffer.
+ * @param flags        RTBCD_TBCD and/or RTBCD_FILLPAD, or 0.
+ * @return             Number of octets written, or a negative status
+ *                       value if an error occurred.
+ */
+EXTERNRT int rtBCDEncode
+(const char* str, OSOCTET* buffer, OSSIZE bufsiz, OSUINT32 flags);
+
+/**
+ * This function converts a BCD or TBCD octet string to a character
+ * string as described for rtBCDDecode with no padding allowed.
+ *
+ * @param numocts      Number of octets.
+ * @param data         Octets to be converted.
+ * @param buffer       Buffer to receive the null-terminated string.
+ * @param bufsiz       Size of the buffer; must be at least 2 * numocts + 1.
+ * @param isTBCD       TRUE for TBCD, FALSE for BCD.
+ * @return             Pointer to the buffer, or NULL if an error occurred.
+ */
+EXTERNRT const char* rtBCDToString
+(OSSIZE numocts, const OSOCTET* data, char* buffer, OSSIZE bufsiz,
+ OSBOOL isTBCD);
+
+/**
+ * This function converts a character string to a BCD or TBCD octet
+ * string as described for rtBCDEncode with no padding.
+ *
+ * @param str          Null-terminated string of digits to be converted.
+ * @param bcdStr       Buffer to receive the octets.
+ * @param bufsiz       Size of the buffer.
+ * @param isTBCD       TRUE for TBCD, FALSE for BCD.
+ * @return             Number of octets written, or a negative status
+ *                       value if an error occurred.
+ */
+EXTERNRT int rtStringToBCD
+(const char* str, OSOCTET* bcdStr, OSSIZE bufsiz, OSBOOL isTBCD);
 
+/**
+ * This function converts a column of BCD or TBCD octet strings to
+ * character strings as described for rtBCDDecode. The strings are written
+ * to a single buffer at a fixed stride. Conversion stops at the first
+ * invalid value; its index is added to the error parameters.
+ *
+ * @param pctxt        Pointer to context structure.
+ * @param values       Array of octet strings to be converted.
+ * @param count        Number of octet strings.
+ * @param buffer       Buffer of count * stride characters to receive the
+ *                       null-terminated strings.
+ * @param stride       Space in the buffer for each string.
+ * @param flags        RTBCD_TBCD and/or RTBCD_FILLPAD, or 0.
+ * @return             Completion status of operation:
+ *                       - 0 = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtBCDDecodeArray
+(OSCTXT* pctxt, const OSDynOctStr* values, OSSIZE count,
+ char* buffer, OSSIZE stride, OSUINT32 flags);
+
+/**
+ * @} rtBCD
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
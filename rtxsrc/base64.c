@@ -15,173 +15,480 @@
  *
  *****************************************************************************/
 
+#include <string.h>
 #include "rtxsrc/rtxCommon.h"
 
-static char getBase64Char (int idx)
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define RTBASE64_SSSE3
+#endif
+
+static const char base64Chars[] =
+"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* Decode */
+
+/*
+ * This array is a lookup table that translates characters drawn from the
+ * "Base64 Alphabet" (as specified in Table 1 of RFC 2045) into their 6-bit
+ * positive integer equivalents. White space and the pad character are
+ * marked with SP and PD; all other characters are invalid (XX).
+ */
+#define XX  0xFF
+#define SP  0xFE
+#define PD  0xFD
+
+static const OSOCTET decodeTable[256] = {
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, SP, SP, SP, SP, SP, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   SP, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, 62, XX, XX, XX, 63,
+   52, 53, 54, 55, 56, 57, 58, 59, 60, 61, XX, XX, XX, PD, XX, XX,
+   XX,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+   15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, XX, XX, XX, XX, XX,
+   XX, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+   41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX
+};
+
+#ifdef RTBASE64_SSSE3
+/* Encode 12 octets as 16 characters (W. Mula and D. Lemire, "Faster    */
+/* Base64 Encoding and Decoding Using AVX2 Instructions").  16 octets   */
+/* are read from the source.                                            */
+
+static void encodeBlock (const OSOCTET* src, char* dest)
 {
-   if (idx >= 0 && idx <= 25) return (char)('A' + (char)idx);
-   else if (idx > 25 && idx <= 51) return (char)('a' + (char)idx - 26);
-   else if (idx > 51 && idx <= 61) return (char)('0' + (char)idx - 52);
-   else if (idx == 62) return '+';
-   else if (idx == 63) return '/';
-   else return -1;
+   __m128i in = _mm_loadu_si128 ((const __m128i*)src);
+   __m128i t0, t1, indices, result, less;
+
+   in = _mm_shuffle_epi8 (in, _mm_set_epi8
+      (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+
+   /* Split each group of three octets into four 6-bit values */
+
+   t0 = _mm_mulhi_epu16 (_mm_and_si128 (in, _mm_set1_epi32 (0x0FC0FC00)),
+                         _mm_set1_epi32 (0x04000040));
+   t1 = _mm_mullo_epi16 (_mm_and_si128 (in, _mm_set1_epi32 (0x003F03F0)),
+                         _mm_set1_epi32 (0x01000010));
+   indices = _mm_or_si128 (t0, t1);
+
+   /* Map each value to its character by adding the offset of its range */
+
+   result = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+   less = _mm_cmpgt_epi8 (_mm_set1_epi8 (26), indices);
+   result = _mm_or_si128 (result, _mm_and_si128 (less, _mm_set1_epi8 (13)));
+   result = _mm_shuffle_epi8 (_mm_setr_epi8
+      ('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+       '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+       '/' - 63, 'A', 0, 0), result);
+
+   _mm_storeu_si128 ((__m128i*)dest, _mm_add_epi8 (result, indices));
 }
 
-long rtxBase64EncodeData
-(OSCTXT* pctxt, const char* pSrcData, size_t srcDataSize, OSOCTET** ppDstData)
+/* Decode 16 characters to 12 octets if all are in the base64 alphabet. */
+/* 16 octets are written to the destination.                            */
+
+static OSBOOL decodeBlock (const OSOCTET* src, OSOCTET* dest)
 {
-   size_t i;
-   OSOCTET* pDstData;
-   size_t numFullGroups = srcDataSize/3;
-   size_t numBytesInPartialGroup = srcDataSize - 3*numFullGroups;
-   size_t resultLen = 4*((srcDataSize + 2)/3);
+   __m128i in = _mm_loadu_si128 ((const __m128i*)src);
+   __m128i hiNibbles = _mm_and_si128 (_mm_srli_epi32 (in, 4),
+                                      _mm_set1_epi8 (0x0F));
+   __m128i loNibbles = _mm_and_si128 (in, _mm_set1_epi8 (0x0F));
+   __m128i lo, hi, roll, merged;
+
+   /* A character is invalid if its nibbles select overlapping classes */
+
+   lo = _mm_shuffle_epi8 (_mm_setr_epi8
+      (0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+       0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), loNibbles);
+   hi = _mm_shuffle_epi8 (_mm_setr_epi8
+      (0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+       0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), hiNibbles);
+
+   if (_mm_movemask_epi8 (_mm_cmpgt_epi8
+       (_mm_and_si128 (lo, hi), _mm_setzero_si128 ())) != 0)
+      return FALSE;
+
+   roll = _mm_shuffle_epi8 (_mm_setr_epi8
+      (0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0),
+      _mm_add_epi8 (_mm_cmpeq_epi8 (in, _mm_set1_epi8 ('/')), hiNibbles));
+   in = _mm_add_epi8 (in, roll);
+
+   /* Pack four 6-bit values into three octets */
+
+   merged = _mm_maddubs_epi16 (in, _mm_set1_epi32 (0x01400140));
+   merged = _mm_madd_epi16 (merged, _mm_set1_epi32 (0x00011000));
+   merged = _mm_shuffle_epi8 (merged, _mm_setr_epi8
+      (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+   _mm_storeu_si128 ((__m128i*)dest, merged);
+
+   return TRUE;
+}
+#endif
+
+/* Encode complete groups of three octets.  Returns the number of       */
+/* octets encoded; the destination must have room for their characters. */
+
+static size_t encodeGroups (const OSOCTET* src, size_t nbytes, char* dest)
+{
+   size_t i = 0;
+   OSUINT32 v;
+
+#ifdef RTBASE64_SSSE3
+   for (; i + 16 <= nbytes; i += 12, dest += 16) {
+      encodeBlock (src + i, dest);
+   }
+#endif
+   for (; i + 3 <= nbytes; i += 3, dest += 4) {
+      v = ((OSUINT32)src[i] << 16) | ((OSUINT32)src[i + 1] << 8) | src[i + 2];
+      dest[0] = base64Chars[v >> 18];
+      dest[1] = base64Chars[(v >> 12) & 0x3F];
+      dest[2] = base64Chars[(v >> 6) & 0x3F];
+      dest[3] = base64Chars[v & 0x3F];
+   }
+
+   return i;
+}
+
+void rtxBase64Init (OSBase64State* pState)
+{
+   if (0 != pState) memset (pState, 0, sizeof(OSBase64State));
+}
+
+long rtxBase64EncodeChunk
+(OSBase64State* pState, const OSOCTET* src, size_t nbytes,
+ char* dest, size_t bufsiz)
+{
+   size_t n = 0, used;
+
+   if (0 == pState || (0 == src && nbytes > 0) || 0 == dest)
+      return RTERR_NULLPTR;
+
+   if ((pState->count + nbytes) / 3 * 4 > bufsiz) return RTERR_STROVFLW;
+
+   /* Complete a group held over from the previous chunk */
 
-   pDstData = *ppDstData = (OSOCTET*) rtxMemAlloc (pctxt, resultLen + 1);
-   if (pDstData == 0) return LOG_RTERR (pctxt, RTERR_NOMEM);
-
-   /* Translate all full groups from byte array elements to Base64 */
-   for (i = 0; i < numFullGroups; i++) {
-       int byte0 = *pSrcData++ & 0xff;
-       int byte1 = *pSrcData++ & 0xff;
-       int byte2 = *pSrcData++ & 0xff;
-       *pDstData++ = getBase64Char (byte0 >> 2);
-       *pDstData++ = getBase64Char (((byte0 << 4) & 0x3f) | (byte1 >> 4));
-       *pDstData++ = getBase64Char (((byte1 << 2) & 0x3f) | (byte2 >> 6));
-       *pDstData++ = getBase64Char (byte2 & 0x3f);
+   if (pState->count > 0) {
+      for (; pState->count < 3 && nbytes > 0; nbytes--) {
+         pState->bits = (pState->bits << 8) | *src++;
+         pState->count++;
+      }
+      if (pState->count < 3) return 0;
+
+      dest[0] = base64Chars[pState->bits >> 18];
+      dest[1] = base64Chars[(pState->bits >> 12) & 0x3F];
+      dest[2] = base64Chars[(pState->bits >> 6) & 0x3F];
+      dest[3] = base64Chars[pState->bits & 0x3F];
+      n = 4;
+      pState->bits = pState->count = 0;
    }
 
-   /* Translate partial group if present */
-   if (numBytesInPartialGroup != 0) {
-       int byte0 = *pSrcData++ & 0xff;
-       *pDstData++ = getBase64Char (byte0 >> 2);
-       if (numBytesInPartialGroup == 1) {
-          *pDstData++ = getBase64Char ((byte0 << 4) & 0x3f);
-          *pDstData++ = '=';
-          *pDstData++ = '=';
-       } else {
-          /* assert numBytesInPartialGroup == 2; */
-          int byte1 = *pSrcData++ & 0xff;
-          *pDstData++ = getBase64Char (((byte0 << 4) & 0x3f) | (byte1 >> 4));
-          *pDstData++ = getBase64Char ((byte1 << 2) & 0x3f);
-          *pDstData++ = '=';
-       }
+   used = encodeGroups (src, nbytes, dest + n);
+   n += used / 3 * 4;
+
+   for (; used < nbytes; used++) {
+      pState->bits = (pState->bits << 8) | src[used];
+      pState->count++;
    }
+
+   return (long)n;
+}
+
+long rtxBase64EncodeFinish (OSBase64State* pState, char* dest, size_t bufsiz)
+{
+   OSUINT32 v;
+
+   if (0 == pState || 0 == dest) return RTERR_NULLPTR;
+   if (pState->count == 0) return 0;
+   if (bufsiz < 4) return RTERR_STROVFLW;
+
+   v = pState->bits << (8 * (3 - pState->count));
+
+   dest[0] = base64Chars[v >> 18];
+   dest[1] = base64Chars[(v >> 12) & 0x3F];
+   dest[2] = (pState->count == 2) ? base64Chars[(v >> 6) & 0x3F] : '=';
+   dest[3] = '=';
+
+   rtxBase64Init (pState);
+
+   return 4;
+}
+
+long rtxBase64Encode
+(const OSOCTET* src, size_t nbytes, char* dest, size_t bufsiz)
+{
+   OSBase64State state;
+   size_t resultLen = 4 * ((nbytes + 2) / 3);
+   long n, stat;
+
+   if (0 == dest) return RTERR_NULLPTR;
+   if (bufsiz <= resultLen) return RTERR_STROVFLW;
+
+   rtxBase64Init (&state);
+
+   n = rtxBase64EncodeChunk (&state, src, nbytes, dest, bufsiz);
+   if (n < 0) return n;
+
+   stat = rtxBase64EncodeFinish (&state, dest + n, bufsiz - (size_t)n);
+   if (stat < 0) return stat;
+
+   dest[resultLen] = '\0';
    return (long)resultLen;
 }
 
-/* Decode */
+long rtxBase64EncodeData
+(OSCTXT* pctxt, const char* pSrcData, size_t srcDataSize, OSOCTET** ppDstData)
+{
+   size_t resultLen = 4*((srcDataSize + 2)/3);
+   long stat;
 
-/*
- * This array is a lookup table that translates characters
- * drawn from the "Base64 Alphabet" (as specified in Table 1 of RFC 2045)
- * into their 6-bit positive integer equivalents. Characters that
- * are not in the Base64 alphabet but fall within the bounds of the
- * array are translated to -1. Note, first 40 values are omitted, because
- * all of them are -1. Use offset -40 to fetch values from this table.
- */
-static const signed char decodeTable[] = {
-   /*
-   -1, -1, -1, -1, -1, -1, -1, -1,
-   -1, -1, -1, -1, -1, -1, -1, -1,
-   -1, -1, -1, -1, -1, -1, -1, -1,
-   -1, -1, -1, -1, -1, -1, -1, -1,
-   -1, -1, -1, -1, -1, -1, -1, -1, */
-   -1, -1, -1, 62, -1, -1, -1, 63,
-   52, 53, 54, 55, 56, 57, 58, 59,
-   60, 61, -1, -1, -1, -1, -1, -1,
-   -1,  0,  1,  2,  3,  4,  5,  6,
-   7,   8,  9, 10, 11, 12, 13, 14,
-   15, 16, 17, 18, 19, 20, 21, 22,
-   23, 24, 25, -1, -1, -1, -1, -1,
-   -1, 26, 27, 28, 29, 30, 31, 32,
-   33, 34, 35, 36, 37, 38, 39, 40,
-   41, 42, 43, 44, 45, 46, 47, 48,
-   49, 50, 51, -1, -1, -1, -1, -1
-};
+   *ppDstData = (OSOCTET*) rtxMemAlloc (pctxt, resultLen + 1);
+   if (*ppDstData == 0) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+   stat = rtxBase64Encode ((const OSOCTET*)pSrcData, srcDataSize,
+                           (char*)*ppDstData, resultLen + 1);
 
-#define BASE64TOINT(c) ((((OSOCTET)c) < 128) ? decodeTable [(c) - 40] : -1)
+   if (stat < 0) {
+      rtxMemFreePtr (pctxt, *ppDstData);
+      *ppDstData = 0;
+      return LOG_RTERR (pctxt, (int)stat);
+   }
+
+   return stat;
+}
 
-static long base64ToBin
-(OSCTXT* pctxt, const char* pSrcData, size_t srcDataSize, OSOCTET* pvalue)
+long rtxBase64DecodeChunk
+(OSBase64State* pState, const char* src, size_t nchars,
+ OSOCTET* dest, size_t bufsiz)
 {
-   size_t i, j = 0;
-   int ch[4]; /* group buffer */
-   OSOCTET* bufp = pvalue;
+   const OSOCTET* s = (const OSOCTET*)src;
+   OSUINT32 bits, count;
+   size_t i = 0, n = 0, end;
+   OSOCTET v;
 
-   for (i = 0; i < srcDataSize; ) {
-      if (OS_ISSPACE (pSrcData[i])) {
-         i++;
-      }
-      else if (pSrcData[i] != '=') {
-         ch[j] = BASE64TOINT (pSrcData[i]);
-         if (ch[j] < 0) {
-            return (0 != pctxt) ?
-               LOG_RTERR (pctxt, RTERR_INVBASE64) : RTERR_INVBASE64;
-         }
-         else if (++j == 4) {
-            /* Group is complete */
-            *pvalue++ = (OSOCTET) ((ch[0] << 2) | (ch[1] >> 4));
-            *pvalue++ = (OSOCTET) ((ch[1] << 4) | (ch[2] >> 2));
-            *pvalue++ = (OSOCTET) ((ch[2] << 6) |  ch[3]);
-            j = 0;
+   if (0 == pState || (0 == src && nchars > 0) || (0 == dest && bufsiz > 0))
+      return RTERR_NULLPTR;
+
+   bits = pState->bits;
+   count = pState->count;
+
+   while (i < nchars) {
+#ifdef RTBASE64_SSSE3
+      /* Decode blocks of 16 characters without white space or padding; */
+      /* otherwise decode this window one character at a time.          */
+
+      if (count == 0 && nchars - i >= 16 && bufsiz - n >= 16) {
+         if (decodeBlock (s + i, dest + n)) {
+            i += 16; n += 12;
+            pState->padded = FALSE;
+            continue;
          }
-         i++;
+         end = i + 16;
       }
-      else { /* partial group */
-         if (j < 2 || j > 3) {
-            return (0 != pctxt) ?
-               LOG_RTERR (pctxt, RTERR_INVBASE64) : RTERR_INVBASE64;
+      else end = nchars;
+#else
+      end = nchars;
+#endif
+      for (; i < end; i++) {
+         v = decodeTable[s[i]];
+
+         if (v < 64) {
+            bits = (bits << 6) | v;
+            pState->padded = FALSE;
+
+            if (++count == 4) {
+               if (bufsiz - n < 3) return RTERR_STROVFLW;
+               dest[n++] = (OSOCTET)(bits >> 16);
+               dest[n++] = (OSOCTET)(bits >> 8);
+               dest[n++] = (OSOCTET)bits;
+               bits = count = 0;
+            }
          }
-         *pvalue++ = (OSOCTET) ((ch[0] << 2) | (ch[1] >> 4));
-         if (j == 3) {
-            *pvalue++ = (OSOCTET) ((ch[1] << 4) | (ch[2] >> 2));
+         else if (v == PD) {
+            /* Padding ends a group of two or three characters; further */
+            /* pad characters are skipped.                              */
+
+            if (count == 2 || count == 3) {
+               if (bufsiz - n < count - 1) return RTERR_STROVFLW;
+               bits <<= 6 * (4 - count);
+               dest[n++] = (OSOCTET)(bits >> 16);
+               if (count == 3) dest[n++] = (OSOCTET)(bits >> 8);
+               bits = count = 0;
+               pState->padded = TRUE;
+            }
+            else if (count != 0 || !pState->padded) return RTERR_INVBASE64;
          }
-         while (pSrcData[i] == '=') i++;
-         j = 0;
+         else if (v != SP) return RTERR_INVBASE64;
       }
    }
 
-   return (long)(pvalue - bufp);
+   pState->bits = bits;
+   pState->count = count;
+
+   return (long)n;
 }
 
-static long getBinDataLen (const char* pSrcData, size_t srcDataSize)
+long rtxBase64DecodeFinish
+(OSBase64State* pState, OSOCTET* dest, size_t bufsiz)
 {
-   size_t i, j = 0;
-   long nbytes = 0;
-   for (i = 0; i < srcDataSize; ) {
-      if (OS_ISSPACE (pSrcData[i])) {
-         i++;
-      }
-      else if (pSrcData[i] != '=') {
-         if (++j == 4) {
-            nbytes += 3;
-            j = 0;
-         }
-         i++;
-      }
-      else { /* partial group */
-         if (j == 2) nbytes += 1;
-         else if (j == 3) nbytes += 2;
-         else return RTERR_INVBASE64;
-         while (pSrcData[i] == '=') i++;
-         j = 0;
-      }
-   }
-   return nbytes;
+   OSUINT32 bits, count;
+
+   if (0 == pState) return RTERR_NULLPTR;
+
+   bits = pState->bits;
+   count = pState->count;
+
+   rtxBase64Init (pState);
+
+   /* Unpadded input may end with a group of two or three characters */
+
+   if (count == 0) return 0;
+   else if (count == 1) return RTERR_INVBASE64;
+   else if (0 == dest) return RTERR_NULLPTR;
+   else if (bufsiz < count - 1) return RTERR_STROVFLW;
+
+   bits <<= 6 * (4 - count);
+   dest[0] = (OSOCTET)(bits >> 16);
+   if (count == 3) dest[1] = (OSOCTET)(bits >> 8);
+
+   return (long)(count - 1);
+}
+
+long rtxBase64Decode
+(const char* src, size_t nchars, OSOCTET* dest, size_t bufsiz)
+{
+   OSBase64State state;
+   long n, stat;
+
+   rtxBase64Init (&state);
+
+   n = rtxBase64DecodeChunk (&state, src, nchars, dest, bufsiz);
+   if (n < 0) return n;
+
+   stat = rtxBase64DecodeFinish (&state, dest + n, bufsiz - (size_t)n);
+
+   return (stat < 0) ? stat : n + stat;
 }
 
 long rtxBase64DecodeData
 (OSCTXT* pctxt, const char* pSrcData, size_t srcDataSize, OSOCTET** ppDstData)
 {
-   size_t bufsiz;
-   OSOCTET* pvalue;
-   long stat = getBinDataLen (pSrcData, srcDataSize);
+   size_t bufsiz = (srcDataSize / 4) * 3 + 2;
+   long stat;
+
+   *ppDstData = (OSOCTET*) rtxMemAlloc (pctxt, bufsiz);
+   if (*ppDstData == 0) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+   stat = rtxBase64Decode (pSrcData, srcDataSize, *ppDstData, bufsiz);
+
+   if (stat < 0) {
+      rtxMemFreePtr (pctxt, *ppDstData);
+      *ppDstData = 0;
+      return LOG_RTERR (pctxt, (int)stat);
+   }
+
+   return stat;
+}
+
+/* PEM (RFC 7468) */
+
+/* Find a string in data[from, size); returns size if it is not found */
+
+static size_t findStr
+(const char* data, size_t size, size_t from, const char* str, size_t len)
+{
+   const char* p;
+
+   while (from + len <= size) {
+      p = (const char*) memchr (data + from, str[0], size - from - len + 1);
+      if (0 == p) break;
+
+      from = (size_t)(p - data);
+      if (0 == memcmp (p, str, len)) return from;
+      from++;
+   }
+
+   return size;
+}
+
+/* Return the offset following the end of the line containing data[from] */
+
+static size_t skipLine (const char* data, size_t size, size_t from)
+{
+   const char* p;
+
+   if (from >= size) return size;
+
+   p = (const char*) memchr (data + from, '\n', size - from);
+
+   return (0 == p) ? size : (size_t)(p - data) + 1;
+}
+
+long rtxPEMDecodeNext
+(const char* data, size_t size, size_t* pOffset, OSOCTET* dest,
+ size_t bufsiz, const char** ppLabel, size_t* pLabelLen)
+{
+   static const char beginStr[] = "-----BEGIN ";
+   static const char endStr[] = "-----END ";
+   size_t begin, label, labelLen, body, end, i;
+   long stat;
+
+   if (0 == data || 0 == pOffset) return RTERR_NULLPTR;
+
+   begin = findStr (data, size, *pOffset, beginStr, sizeof(beginStr) - 1);
+   if (begin == size) {
+      *pOffset = size;
+      return RTERR_ENDOFBUF;
+   }
+
+   /* A block that is not valid is skipped up to the end of its END line */
+   /* or, if it has none, of its BEGIN line, so that the caller can go   */
+   /* on with the next block.                                            */
+
+   *pOffset = skipLine (data, size, begin);
+
+   /* The label is followed by five hyphens on the same line */
+
+   label = begin + sizeof(beginStr) - 1;
+   for (i = label; i < size && data[i] != '-'; i++) {
+      if (data[i] == '\n' || data[i] == '\r') return RTERR_INVFORMAT;
+   }
+   labelLen = i - label;
+   if (i + 5 > size || 0 != memcmp (data + i, "-----", 5))
+      return RTERR_INVFORMAT;
+
+   body = i + 5;
+
+   /* The block has no END line if another block begins first */
+
+   end = findStr (data, size, body, endStr, sizeof(endStr) - 1);
+   if (end == size ||
+       findStr (data, size, body, beginStr, sizeof(beginStr) - 1) < end)
+      return RTERR_INVFORMAT;
+
+   /* The END line must have the same label */
+
+   *pOffset = skipLine (data, size, end);
+
+   i = end + sizeof(endStr) - 1;
+   if (i + labelLen + 5 > size ||
+       0 != memcmp (data + i, data + label, labelLen) ||
+       0 != memcmp (data + i + labelLen, "-----", 5))
+      return RTERR_INVFORMAT;
 
-   if (stat < 0) return LOG_RTERR (pctxt, (int)stat);
-   else bufsiz = (size_t) stat;
+   stat = rtxBase64Decode (data + body, end - body, dest, bufsiz);
+   if (stat < 0) return stat;
 
-   pvalue = *ppDstData = (OSOCTET*) rtxMemAlloc (pctxt, bufsiz);
-   if (pvalue == 0) return LOG_RTERR (pctxt, RTERR_NOMEM);
+   *pOffset = i + labelLen + 5;
+   if (0 != ppLabel) *ppLabel = data + label;
+   if (0 != pLabelLen) *pLabelLen = labelLen;
 
-   return base64ToBin (pctxt, pSrcData, srcDataSize, pvalue);
+   return stat;
 }
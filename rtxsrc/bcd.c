@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "rtsrc/rtBCD.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RTBCD_SSE2
+#endif
+
+#define BCD_FILLER 0x0F
+
+/* Characters for nibble values 0 to 14 (3GPP TS 29.002 TBCD-STRING) */
+
+static const char bcdChars[16] = "0123456789*#abc";
+
+static int charToNibble (char c)
+{
+   if (c >= '0' && c <= '9') return c - '0';
+
+   switch (c) {
+   case '*': return 0x0A;
+   case '#': return 0x0B;
+   case 'a': case 'A': return 0x0C;
+   case 'b': case 'B': return 0x0D;
+   case 'c': case 'C': return 0x0E;
+   default:  return -1;
+   }
+}
+
+#ifdef RTBCD_SSE2
+/* Unpack blocks of 8 octets holding only decimal digits, 16 characters */
+/* at a time.  Returns the number of octets unpacked; unpacking stops   */
+/* at the first block containing any other nibble value.                */
+
+static OSSIZE unpackDecimalBlocks
+(const OSOCTET* data, OSSIZE numocts, char* buffer, OSBOOL tbcd)
+{
+   const __m128i mask = _mm_set1_epi8 (0x0F);
+   const __m128i nine = _mm_set1_epi8 (9);
+   const __m128i zero = _mm_set1_epi8 ('0');
+   OSSIZE i;
+
+   for (i = 0; i + 8 <= numocts; i += 8) {
+      __m128i v  = _mm_loadl_epi64 ((const __m128i*)(data + i));
+      __m128i lo = _mm_and_si128 (v, mask);
+      __m128i hi = _mm_and_si128 (_mm_srli_epi16 (v, 4), mask);
+
+      if (_mm_movemask_epi8 (_mm_or_si128 (_mm_cmpgt_epi8 (lo, nine),
+                                           _mm_cmpgt_epi8 (hi, nine))))
+         break;
+
+      lo = _mm_add_epi8 (lo, zero);
+      hi = _mm_add_epi8 (hi, zero);
+
+      _mm_storeu_si128 ((__m128i*)(buffer + (2 * i)), (tbcd) ?
+                        _mm_unpacklo_epi8 (lo, hi) :
+                        _mm_unpacklo_epi8 (hi, lo));
+   }
+
+   return i;
+}
+#endif
+
+int rtBCDDecode
+(const OSOCTET* data, OSSIZE numocts, char* buffer, OSSIZE bufsiz,
+ OSUINT32 flags)
+{
+   OSBOOL tbcd = (OSBOOL)((flags & RTBCD_TBCD) != 0);
+   OSSIZE i = 0, n = 0, ndigits = numocts * 2;
+   int    first, second;
+
+   if ((0 == data && numocts > 0) || 0 == buffer) return RTERR_NULLPTR;
+
+   /* The decoded string is at most two digits per octet */
+
+   if (ndigits >= bufsiz || ndigits > (OSSIZE)OSINT32_MAX)
+      return RTERR_STROVFLW;
+
+#ifdef RTBCD_SSE2
+   /* The last octet may hold a filler, so leave it to the scalar loop */
+   if (numocts > 8) {
+      i = unpackDecimalBlocks (data, numocts - 1, buffer, tbcd);
+      n = i * 2;
+   }
+#endif
+
+   for (; i < numocts; i++) {
+      first = (tbcd) ? (data[i] & 0x0F) : (data[i] >> 4);
+      second = (tbcd) ? (data[i] >> 4) : (data[i] & 0x0F);
+
+      if (first == BCD_FILLER) break;
+      buffer[n++] = bcdChars[first];
+
+      if (second == BCD_FILLER) {
+         i++;
+         break;
+      }
+      buffer[n++] = bcdChars[second];
+   }
+
+   /* A filler may only appear as the last nibble unless padding is     */
+   /* allowed, in which case everything after the digits must be fill.  */
+
+   if (n != ndigits && !(n + 1 == ndigits && i == numocts)) {
+      if (!(flags & RTBCD_FILLPAD)) return RTERR_BADVALUE;
+
+      for (; i < numocts; i++) {
+         if (data[i] != 0xFF) return RTERR_BADVALUE;
+      }
+   }
+
+   buffer[n] = '\0';
+   return (int)n;
+}
+
+int rtBCDEncode
+(const char* str, OSOCTET* buffer, OSSIZE bufsiz, OSUINT32 flags)
+{
+   OSBOOL tbcd = (OSBOOL)((flags & RTBCD_TBCD) != 0);
+   OSSIZE nchars, numocts, i;
+   int    first, second;
+
+   if (0 == str || 0 == buffer) return RTERR_NULLPTR;
+
+   nchars = strlen (str);
+   numocts = (nchars + 1) / 2;
+
+   if (numocts > bufsiz || bufsiz > (OSSIZE)OSINT32_MAX)
+      return RTERR_STROVFLW;
+
+   for (i = 0; i < numocts; i++) {
+      first = charToNibble (str[2 * i]);
+      second = (2 * i + 1 < nchars) ?
+         charToNibble (str[2 * i + 1]) : BCD_FILLER;
+
+      if (first < 0 || second < 0) return RTERR_INVCHAR;
+
+      buffer[i] = (OSOCTET)((tbcd) ?
+         ((second << 4) | first) : ((first << 4) | second));
+   }
+
+   if (flags & RTBCD_FILLPAD) {
+      memset (buffer + numocts, 0xFF, bufsiz - numocts);
+      numocts = bufsiz;
+   }
+
+   return (int)numocts;
+}
+
+const char* rtBCDToString
+(OSSIZE numocts, const OSOCTET* data, char* buffer, OSSIZE bufsiz,
+ OSBOOL isTBCD)
+{
+   int stat = rtBCDDecode
+      (data, numocts, buffer, bufsiz, (isTBCD) ? RTBCD_TBCD : 0);
+
+   return (stat < 0) ? 0 : buffer;
+}
+
+int rtStringToBCD
+(const char* str, OSOCTET* bcdStr, OSSIZE bufsiz, OSBOOL isTBCD)
+{
+   return rtBCDEncode (str, bcdStr, bufsiz, (isTBCD) ? RTBCD_TBCD : 0);
+}
+
+int rtBCDDecodeArray
+(OSCTXT* pctxt, const OSDynOctStr* values, OSSIZE count,
+ char* buffer, OSSIZE stride, OSUINT32 flags)
+{
+   OSSIZE i;
+   int stat;
+
+   if (count > 0 && (0 == values || 0 == buffer))
+      return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   for (i = 0; i < count; i++) {
+      stat = rtBCDDecode (values[i].data, values[i].numocts,
+                          buffer + (i * stride), stride, flags);
+      if (stat < 0) {
+         rtxErrAddUIntParm (pctxt, (OSUINT32)i);
+         return LOG_RTERR (pctxt, stat);
+      }
+   }
+
+   return 0;
+}
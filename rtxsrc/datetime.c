@@ -15,9 +15,7 @@
  *
  *****************************************************************************/
 
-#include <math.h>
 #include <string.h>
-#include <stdio.h>
 #include "rtxsrc/rtxCommon.h"
 
 const signed char gDaysInMonth[12] =
@@ -62,9 +60,63 @@ OSBOOL rtxDateTimeIsValid (const OSNumDateTime* dateTime)
    return (OSBOOL)(rtxDateIsValid (dateTime) && rtxTimeIsValid (dateTime));
 }
 
+/* Conversion between civil dates and days since 1970-01-01 in the      */
+/* proleptic Gregorian calendar, using only integer arithmetic.         */
+
+static OSINT64 daysFromCivil (OSINT32 year, unsigned mon, unsigned day)
+{
+   OSINT32  era;
+   unsigned yoe, doy, doe;
+
+   year -= (mon <= 2);
+   era = ((year >= 0) ? year : year - 399) / 400;
+   yoe = (unsigned)(year - (era * 400));
+   doy = ((153 * ((mon > 2) ? mon - 3 : mon + 9)) + 2) / 5 + day - 1;
+   doe = (yoe * 365) + (yoe / 4) - (yoe / 100) + doy;
+
+   return ((OSINT64)era * 146097) + (OSINT64)doe - 719468;
+}
+
+/* The year is returned as a 64-bit value for the caller to check      */
+/* before narrowing it.                                                  */
+
+static OSINT64 civilFromDays (OSINT64 days, unsigned* pmon, unsigned* pday)
+{
+   OSINT64  era;
+   unsigned doe, yoe, doy, mp;
+
+   days += 719468;
+   era = ((days >= 0) ? days : days - 146096) / 146097;
+   doe = (unsigned)(days - (era * 146097));
+   yoe = (doe - (doe / 1460) + (doe / 36524) - (doe / 146096)) / 365;
+   doy = doe - ((365 * yoe) + (yoe / 4) - (yoe / 100));
+   mp = ((5 * doy) + 2) / 153;
+
+   *pday = doy - (((153 * mp) + 2) / 5) + 1;
+   *pmon = (mp < 10) ? mp + 3 : mp - 9;
+   return (OSINT64)yoe + (era * 400) + (*pmon <= 2);
+}
+
 #define SEC_PRECISION 0.0000005
 
-static void normalizeTimeZone(OSNumDateTime*);
+#define CMP(a,b) (((a) > (b)) - ((a) < (b)))
+
+static int cmpSec (OSREAL sec1, OSREAL sec2)
+{
+   return (sec1 > sec2 + SEC_PRECISION) - (sec1 < sec2 - SEC_PRECISION);
+}
+
+/* Minutes since 1970-01-01 00:00 of the date, hour and minute of a    */
+/* date/time value, adjusted to UTC if a time zone is set.              */
+
+static OSINT64 epochMinutes (const OSNumDateTime* pvalue)
+{
+   OSINT64 mins =
+      (daysFromCivil (pvalue->year, pvalue->mon, pvalue->day) * 1440) +
+      (pvalue->hour * 60) + pvalue->min;
+
+   return (pvalue->tz_flag) ? mins - pvalue->tzo : mins;
+}
 
  /**
   * rtxCmpDate:
@@ -73,27 +125,11 @@ static void normalizeTimeZone(OSNumDateTime*);
   */
 int rtxCmpDate (const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2)
 {
+   int stat = CMP (pvalue1->year, pvalue2->year);
+
+   if (stat == 0) stat = CMP (pvalue1->mon, pvalue2->mon);
+   if (stat == 0) stat = CMP (pvalue1->day, pvalue2->day);
 
-   int stat = 0;
-   if (pvalue1->year > pvalue2->year) {
-      stat = 1;
-   } else if (pvalue1->year < pvalue2->year) {
-      stat = -1;
-   } else {
-      if (pvalue1->mon > pvalue2->mon) {
-         stat = 1;
-      } else if (pvalue1->mon < pvalue2->mon) {
-         stat = -1;
-      } else {
-         if (pvalue1->day > pvalue2->day) {
-            stat = 1;
-         } else if (pvalue1->day < pvalue2->day) {
-            stat = -1;
-         } else {
-            stat = 0;
-         }
-      }
-   }
    return stat;
 }
 
@@ -104,27 +140,11 @@ int rtxCmpDate (const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2)
  */
 int rtxCmpTime (const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2)
 {
-   int stat = 0;
-   if (pvalue1->hour  > pvalue2->hour) {
-      stat = 1;
-   } else if (pvalue1->hour < pvalue2->hour) {
-      stat = -1;
-   } else {
-      if (pvalue1->min > pvalue2->min) {
-         stat = 1;
-      } else if (pvalue1->min < pvalue2->min) {
-         stat = -1;
-      } else {
-         if (pvalue1->sec > pvalue2->sec + SEC_PRECISION) {
-            stat = 1;
-         } else if (pvalue1->sec < pvalue2->sec  - SEC_PRECISION) {
-            stat = -1;
-         } else {
-            stat = 0;
-         }
-      }
-   }
-   return stat;
+   int time1 = (pvalue1->hour * 60) + pvalue1->min;
+   int time2 = (pvalue2->hour * 60) + pvalue2->min;
+   int stat = CMP (time1, time2);
+
+   return (stat != 0) ? stat : cmpSec (pvalue1->sec, pvalue2->sec);
 }
 
 /**
@@ -134,151 +154,176 @@ int rtxCmpTime (const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2)
  */
 int rtxCmpDateTime (const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2)
 {
-   int stat = 0;
-   OSNumDateTime tmpvalue1, tmpvalue2;
-   if (pvalue1->tz_flag == (OSBOOL)TRUE) {
-      memcpy (&tmpvalue1, pvalue1, sizeof(OSNumDateTime));
-      normalizeTimeZone (&tmpvalue1);
-      pvalue1 = &tmpvalue1;
-   }
-   if (pvalue2->tz_flag == (OSBOOL)TRUE) {
-      memcpy (&tmpvalue2, pvalue2, sizeof(OSNumDateTime));
-      normalizeTimeZone (&tmpvalue2);
-      pvalue2 = &tmpvalue2;
-   }
+   OSINT64 mins1 = epochMinutes (pvalue1);
+   OSINT64 mins2 = epochMinutes (pvalue2);
+   int stat = CMP (mins1, mins2);
 
-   stat = rtxCmpDate(pvalue1, pvalue2);
-   if (stat == 0)  stat = rtxCmpTime(pvalue1, pvalue2);
-   return stat;
+   return (stat != 0) ? stat : cmpSec (pvalue1->sec, pvalue2->sec);
 }
 
-/**
- * normalizeTimeZone:
- * This function normalizes the Time Zone value of OSNumDateTime structure.
- */
-#define IS_LEAP(y) (((y % 4 == 0) && (y % 100 != 0)) || (y % 400 == 0))
-#define FQUOTIENT(a,b)  (int)(floor((double)a/(double)b))
-#define FQUOTIENT_RANGE(a,low,high)  (FQUOTIENT((a-low),(high-low)))
-#define MODULO(a,b)     (a - (FQUOTIENT(a,b))*b)
-#define MODULO_RANGE(a,low,high) ((MODULO((a-low),(high-low)))+low)
-#define MAX_DAY_INMONTH(yr,mon) \
-((IS_LEAP(yr)&& mon == 2)? (gDaysInMonth[mon-1] + 1) : gDaysInMonth[mon-1])
-
-static void normalizeTimeZone(OSNumDateTime* pvalue)
+OSINT64 rtxDateTimeDiff
+(const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2)
 {
-   OSINT32 tmp, carry, tmpdays;
-   tmp = pvalue->min - pvalue->tzo;
-   pvalue->min = (OSINT8)(MODULO(tmp,60));
-   carry = FQUOTIENT(tmp,60);
-   tmp = pvalue->hour + carry;
-   pvalue->hour = (OSINT8)(MODULO(tmp,24));
-   carry = FQUOTIENT(tmp,24);
-   tmpdays = pvalue->day + carry;
-
-   for (;;) {
-      if(tmpdays < 1){
-         int tmon = MODULO_RANGE(pvalue->mon-1, 1, 13);
-         int tyr  = pvalue->year + FQUOTIENT_RANGE(pvalue->mon-1, 1, 13);
-         if (tyr == 0)
-            tyr--;
-         tmpdays += MAX_DAY_INMONTH(tyr, tmon);
-         carry = -1;
-      } else if (tmpdays > MAX_DAY_INMONTH(pvalue->year, pvalue->mon)){
-         tmpdays = tmpdays - MAX_DAY_INMONTH(pvalue->year, pvalue->mon);
-         carry = 1;
-      } else
-         break;
-      tmp = pvalue->mon + carry;
-      pvalue->mon = (OSINT8)(MODULO_RANGE(tmp,1,13));
-      pvalue->year = (OSINT8)(pvalue->year + FQUOTIENT_RANGE(tmp,1,13));
-   }
-   pvalue->day = (OSINT8)tmpdays;
+   return ((epochMinutes (pvalue1) - epochMinutes (pvalue2)) * 60) +
+      ((OSINT32)pvalue1->sec - (OSINT32)pvalue2->sec);
 }
 
-int rtParseGeneralizedTime
-(OSCTXT *pctxt, const char* value, OSNumDateTime* dateTime)
+void rtxDateTimeNormalize (OSNumDateTime* pvalue)
+{
+   OSINT64  mins, days, year;
+   OSINT32  rem;
+   unsigned mon, day;
+
+   if (!pvalue->tz_flag || pvalue->tzo == 0) return;
+
+   mins = epochMinutes (pvalue);
+   days = mins / 1440;
+   rem = (OSINT32)(mins % 1440);
+   if (rem < 0) { rem += 1440; days--; }
+
+   year = civilFromDays (days, &mon, &day);
+   if (year < OSINT32_MIN || year > OSINT32_MAX) return;
+
+   pvalue->year = (OSINT32)year;
+   pvalue->mon = (OSUINT8)mon;
+   pvalue->day = (OSUINT8)day;
+   pvalue->hour = (OSUINT8)(rem / 60);
+   pvalue->min = (OSUINT8)(rem % 60);
+   pvalue->tzo = 0;
+}
+
+/* Fixed-width decimal field parsing.  Each function returns the value  */
+/* of the field, or -1 if the string ends first or a character is not a */
+/* digit.                                                               */
+
+static int parse2 (const char* p, const char* end)
+{
+   unsigned d0, d1;
+
+   if (end - p < 2) return -1;
+
+   d0 = (unsigned)(p[0] - '0');
+   d1 = (unsigned)(p[1] - '0');
+
+   return (d0 <= 9 && d1 <= 9) ? (int)((d0 * 10) + d1) : -1;
+}
+
+static int parse4 (const char* p, const char* end)
 {
-   int year, month, day, hour, minute, second, diffhour, diffmin;
-   OSREAL fracsec = 0.0, mult = 0.1;
-   char tzd;
-   const char* p = value;
+   int hi = parse2 (p, end), lo;
 
-   year = month = day = hour = RTERR_IDNOTFOU;
-   minute = second = diffhour = diffmin = 0;
+   if (hi < 0) return -1;
+   lo = parse2 (p + 2, end);
 
-   if(sscanf(p, "%4d%2d%2d", &year, &month, &day) == 3) {
-      int n = 0;
-      p += 8;
+   return (lo < 0) ? -1 : (hi * 100) + lo;
+}
+
+/* Parse a GeneralizedTime (YYYYMMDDHH[MM[SS[.f]]][Z|+-hh[mm]]) or       */
+/* UTCTime (YYMMDDHHMM[SS](Z|+-hhmm)) string.  The fraction of a second */
+/* is returned in nanoseconds; further digits are ignored.              */
 
-      if (OS_ISDIGIT(*p) && sscanf(p, "%2d", &hour) >= 1) {
+static int parseTimeStr
+(const char* p, const char* end, OSBOOL utcTime, OSNumDateTime* dateTime,
+ OSUINT32* pnsecs)
+{
+   int year, month, day, hour, minute = 0, second = 0;
+   int diffhour = 0, diffmin = 0, v;
+   OSUINT32 nsecs = 0, mult = 100000000;
+   OSBOOL haveSec = FALSE;
+   char tzd = 0;
+
+   if (utcTime) {
+      if ((year = parse2 (p, end)) < 0) return RTERR_INVFORMAT;
+      year += (year >= 50) ? 1900 : 2000;
+      p += 2;
+   }
+   else {
+      if ((year = parse4 (p, end)) < 0) return RTERR_INVFORMAT;
+      p += 4;
+   }
+
+   if ((month = parse2 (p, end)) < 0 ||
+       (day = parse2 (p + 2, end)) < 0 ||
+       (hour = parse2 (p + 4, end)) < 0)
+      return RTERR_INVFORMAT;
+   p += 6;
+
+   if ((v = parse2 (p, end)) >= 0) {
+      minute = v;
+      p += 2;
+      if ((v = parse2 (p, end)) >= 0) {
+         second = v;
+         haveSec = TRUE;
          p += 2;
-         n++;
       }
-      else
-         return LOG_RTERR(pctxt, RTERR_INVFORMAT);
+   }
+   else if (utcTime) return RTERR_INVFORMAT;
 
-      if (OS_ISDIGIT(*p) && sscanf(p, "%2d", &minute) >= 1) {
-         p += 2;
-         n++;
-         if (OS_ISDIGIT(*p) && sscanf(p, "%2d", &second) >= 1) {
-            p += 2;
-            n++;
-         }
+   if (!utcTime && p < end && (*p == '.' || *p == ',')) {
+      /* fraction second can be present if second is present */
+      if (!haveSec || ++p == end || !OS_ISDIGIT (*p))
+         return RTERR_INVFORMAT;
+
+      for (; p < end && OS_ISDIGIT (*p); p++) {
+         nsecs += (OSUINT32)(*p - '0') * mult;
+         mult /= 10;
       }
+   }
 
-      if (*p == '.' || *p == ',') { /* fraction */
-         int j;
-         p++;
+   dateTime->tz_flag = FALSE;
 
-         if(n < 3) /* fraction second can be present if second is present */
-            return LOG_RTERR(pctxt, RTERR_INVFORMAT);
+   if (p < end && *p == 'Z') { /* utc */
+      dateTime->tz_flag = TRUE;
+      p++;
+   }
+   else if (p < end && (*p == '-' || *p == '+')) {
+      dateTime->tz_flag = TRUE;
+      tzd = *p++;
 
-         /* parse next fraction second */
-         for (j = 0; OS_ISDIGIT(*p); j++, p++) {
-            fracsec += ((*p - '0') * mult);
-            mult /= 10.0;
-         }
-         if (j == 0)
-            return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-      }
-      dateTime->tz_flag = FALSE;
-      tzd = *p;
-      if (tzd == 'Z') { /* utc */
-         dateTime->tz_flag = TRUE;
-         p++;
-         if(*p != 0)
-            return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-      }
-      else if (tzd == '-' || tzd == '+') {
-         dateTime->tz_flag = TRUE;
-         p++;
-         if (!OS_ISDIGIT(*p) || sscanf(p, "%2d", &diffhour) != 1)
-            return LOG_RTERR(pctxt, RTERR_INVFORMAT);
+      if ((diffhour = parse2 (p, end)) < 0 || diffhour > 12)
+         return RTERR_INVFORMAT;
+      p += 2;
+
+      if ((v = parse2 (p, end)) >= 0) {
+         if (v > 59) return RTERR_INVFORMAT;
+         diffmin = v;
          p += 2;
-         if(diffhour < 0 || diffhour > 12)
-            return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-         if(OS_ISDIGIT(*p)) {
-            if(sscanf(p, "%2d", &diffmin) != 1)
-               return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-            if(diffmin < 0 || diffmin > 59)
-               return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-         }
       }
+      else if (utcTime) return RTERR_INVFORMAT;
    }
-   else
-      return LOG_RTERR(pctxt, RTERR_INVFORMAT);
+   else if (utcTime) {
+      /* UTCTime must include a time zone */
+      return RTERR_INVFORMAT;
+   }
+
+   if (p != end) return RTERR_INVFORMAT;
 
    dateTime->year = (OSINT32)year;
    dateTime->mon = (OSUINT8)month;
    dateTime->day = (OSUINT8)day;
    dateTime->hour = (OSUINT8)hour;
    dateTime->min = (OSUINT8)minute;
-   dateTime->sec = (OSREAL)second + fracsec;
+   dateTime->sec = (OSREAL)second;
    dateTime->tzo = (diffhour * 60) + diffmin;
    if (tzd == '-') dateTime->tzo *= -1;
 
    if (!rtxDateTimeIsValid (dateTime))
-      return LOG_RTERR (pctxt, RTERR_INVFORMAT);
+      return RTERR_INVFORMAT;
+
+   *pnsecs = nsecs;
+   return 0;
+}
+
+int rtParseGeneralizedTime
+(OSCTXT *pctxt, const char* value, OSNumDateTime* dateTime)
+{
+   OSUINT32 nsecs;
+   int stat = parseTimeStr
+      (value, value + strlen (value), FALSE, dateTime, &nsecs);
+
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   dateTime->sec += (OSREAL)nsecs / 1e9;
 
    return 0;
 }
@@ -286,87 +331,216 @@ int rtParseGeneralizedTime
 int rtParseUTCTime
 (OSCTXT *pctxt, const char* value, OSNumDateTime* dateTime)
 {
-   int year, month, day, hour, minute, second, diffhour, diffmin;
-   char tzd;
-   const char* p = value;
+   OSUINT32 nsecs;
+   int stat = parseTimeStr
+      (value, value + strlen (value), TRUE, dateTime, &nsecs);
 
-   year = month = day = hour = minute = RTERR_IDNOTFOU;
-   second = diffhour = diffmin = 0;
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
 
-   if (sscanf(p, "%2d%2d%2d", &year, &month, &day) == 3) {
-      int n = 0;
-      p += 6;
+   return 0;
+}
 
-      if (year < 0)
-         return LOG_RTERR(pctxt, RTERR_INVFORMAT);
+int rtxDateTimeToEpoch (const OSNumDateTime* dateTime, OSINT64* pSecs)
+{
+   if (0 == dateTime || 0 == pSecs) return RTERR_NULLPTR;
+   if (!rtxDateTimeIsValid (dateTime)) return RTERR_BADVALUE;
 
-      if (year < 100) {
-         if (year >= 50)
-            year += 1900;
-         else
-            year += 2000;
-      }
+   *pSecs = (epochMinutes (dateTime) * 60) + (OSINT32)dateTime->sec;
 
-      if (OS_ISDIGIT(*p) && sscanf(p, "%2d", &hour) >= 1) {
-         p += 2;
-         n++;
-      }
-      else
-         return LOG_RTERR(pctxt, RTERR_INVFORMAT);
+   return 0;
+}
 
-      if (OS_ISDIGIT(*p) && sscanf(p, "%2d", &minute) >= 1) {
-         p += 2;
-         n++;
-         if (OS_ISDIGIT(*p) && sscanf(p, "%2d", &second) >= 1) {
-            p += 2;
-            n++;
-         }
-      }
-      else
-         return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-
-      dateTime->tz_flag = FALSE;
-      tzd = *p;
-      if (tzd == 'Z') { /* utc | GMT */
-         dateTime->tz_flag = TRUE;
-         if (*++p != 0)
-            return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-      }
-      else {
-         /* DER/CER/PER time should be terminated with 'Z'!
-             else return LOG_RTERR(pctxt, RTERR_INVFORMAT); */
-         if (tzd == '-' || tzd == '+') {
-            dateTime->tz_flag = TRUE;
-            p++;
-            if(!OS_ISDIGIT(*p) || sscanf(p, "%2d", &diffhour) != 1)
-               return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-            p += 2;
-            if(!OS_ISDIGIT(*p) || sscanf(p, "%2d", &diffmin) != 1)
-               return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-            if(diffhour < 0 || diffhour > 12)
-               return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-            if(diffmin < 0 || diffmin > 59)
-               return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-         }
-         else {
-            return LOG_RTERR(pctxt, RTERR_INVFORMAT);
-         }
-      }
+int rtxDateTimeToEpochArray
+(const OSNumDateTime* values, OSSIZE count, OSINT64* pSecs)
+{
+   OSSIZE i;
+   OSBOOL valid = TRUE;
+
+   if (count > 0 && (0 == values || 0 == pSecs)) return RTERR_NULLPTR;
+
+   for (i = 0; i < count; i++) {
+      valid &= rtxDateTimeIsValid (&values[i]);
+      pSecs[i] = (epochMinutes (&values[i]) * 60) + (OSINT32)values[i].sec;
    }
-   else
-      return LOG_RTERR(pctxt, RTERR_INVFORMAT);
+
+   return (valid) ? 0 : RTERR_BADVALUE;
+}
+
+int rtxEpochToDateTime
+(OSINT64 secs, OSUINT32 nsecs, OSNumDateTime* dateTime)
+{
+   OSINT64  days = secs / 86400, year;
+   OSINT32  rem = (OSINT32)(secs % 86400);
+   unsigned mon, day;
+
+   if (0 == dateTime) return RTERR_NULLPTR;
+   if (nsecs >= 1000000000) return RTERR_BADVALUE;
+
+   if (rem < 0) { rem += 86400; days--; }
+
+   year = civilFromDays (days, &mon, &day);
+   if (year < OSINT32_MIN || year > OSINT32_MAX) return RTERR_BADVALUE;
 
    dateTime->year = (OSINT32)year;
-   dateTime->mon = (OSUINT8)month;
+   dateTime->mon = (OSUINT8)mon;
    dateTime->day = (OSUINT8)day;
-   dateTime->hour = (OSUINT8)hour;
-   dateTime->min = (OSUINT8)minute;
-   dateTime->sec = (OSREAL)second;
-   dateTime->tzo = (diffhour * 60) + diffmin;
-   if (tzd == '-') dateTime->tzo *= -1;
+   dateTime->hour = (OSUINT8)(rem / 3600);
+   dateTime->min = (OSUINT8)((rem / 60) % 60);
+   dateTime->sec = (OSREAL)(rem % 60) + ((OSREAL)nsecs / 1e9);
+   dateTime->tz_flag = TRUE;
+   dateTime->tzo = 0;
 
-   if (!rtxDateTimeIsValid (dateTime))
-      return LOG_RTERR (pctxt, RTERR_INVFORMAT);
+   return 0;
+}
+
+static int parseEpoch
+(OSCTXT *pctxt, const char* value, OSBOOL utcTime, OSINT64* pSecs,
+ OSUINT32* pNsecs)
+{
+   OSNumDateTime dateTime;
+   OSUINT32 nsecs;
+   int stat;
+
+   if (0 == value || 0 == pSecs) return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   stat = parseTimeStr
+      (value, value + strlen (value), utcTime, &dateTime, &nsecs);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   rtxDateTimeToEpoch (&dateTime, pSecs);
+   if (0 != pNsecs) *pNsecs = nsecs;
+
+   return 0;
+}
+
+int rtParseGeneralizedTimeEpoch
+(OSCTXT *pctxt, const char* value, OSINT64* pSecs, OSUINT32* pNsecs)
+{
+   return parseEpoch (pctxt, value, FALSE, pSecs, pNsecs);
+}
+
+int rtParseUTCTimeEpoch (OSCTXT *pctxt, const char* value, OSINT64* pSecs)
+{
+   return parseEpoch (pctxt, value, TRUE, pSecs, 0);
+}
+
+static int parseEpochArray
+(OSCTXT *pctxt, const char* const* values, OSSIZE count, OSBOOL utcTime,
+ OSINT64* pSecs, OSUINT32* pNsecs)
+{
+   OSSIZE i;
+   int stat;
+
+   if (count > 0 && (0 == values || 0 == pSecs))
+      return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   for (i = 0; i < count; i++) {
+      stat = parseEpoch (pctxt, values[i], utcTime, &pSecs[i],
+                         (0 != pNsecs) ? &pNsecs[i] : 0);
+      if (stat != 0) {
+         rtxErrAddUIntParm (pctxt, (OSUINT32)i);
+         return LOG_RTERR (pctxt, stat);
+      }
+   }
+
+   return 0;
+}
+
+int rtParseGeneralizedTimeArray
+(OSCTXT *pctxt, const char* const* values, OSSIZE count,
+ OSINT64* pSecs, OSUINT32* pNsecs)
+{
+   return parseEpochArray (pctxt, values, count, FALSE, pSecs, pNsecs);
+}
+
+int rtParseUTCTimeArray
+(OSCTXT *pctxt, const char* const* values, OSSIZE count, OSINT64* pSecs)
+{
+   return parseEpochArray (pctxt, values, count, TRUE, pSecs, 0);
+}
+
+/* Fixed-width decimal field formatting */
+
+static char* put2 (char* p, unsigned value)
+{
+   p[0] = (char)('0' + (value / 10));
+   p[1] = (char)('0' + (value % 10));
+   return p + 2;
+}
+
+/* Format the date and time of day in UTC as YYYYMMDDHHMMSS, or as     */
+/* YYMMDDHHMMSS if utcTime is true.  Returns a pointer past the text,  */
+/* or null if the year is not in the range minYear to maxYear.         */
+
+static char* formatTime
+(char* p, OSINT64 secs, OSBOOL utcTime, OSINT32 minYear, OSINT32 maxYear)
+{
+   OSINT64  days = secs / 86400, year;
+   OSINT32  rem = (OSINT32)(secs % 86400);
+   unsigned mon, day;
+
+   if (rem < 0) { rem += 86400; days--; }
+
+   year = civilFromDays (days, &mon, &day);
+   if (year < minYear || year > maxYear) return 0;
+
+   if (!utcTime) p = put2 (p, (unsigned)(year / 100) % 100);
+   p = put2 (p, (unsigned)(year % 100));
+   p = put2 (p, mon);
+   p = put2 (p, day);
+   p = put2 (p, (unsigned)(rem / 3600));
+   p = put2 (p, (unsigned)((rem / 60) % 60));
+   p = put2 (p, (unsigned)(rem % 60));
+
+   return p;
+}
+
+int rtFormatGeneralizedTime
+(OSCTXT *pctxt, OSINT64 secs, OSUINT32 nsecs, char* buffer, size_t bufsiz)
+{
+   char  tmpbuf[32];
+   char* p;
+   int   i;
+
+   if (0 == buffer) return LOG_RTERR (pctxt, RTERR_NULLPTR);
+   if (nsecs >= 1000000000) return LOG_RTERR (pctxt, RTERR_BADVALUE);
+
+   p = formatTime (tmpbuf, secs, FALSE, 0, 9999);
+   if (0 == p) return LOG_RTERR (pctxt, RTERR_BADVALUE);
+
+   if (nsecs != 0) {
+      /* Fraction with trailing zeros removed, as required by DER */
+      *p++ = '.';
+      for (i = 8; i >= 0; i--, nsecs /= 10) p[i] = (char)('0' + (nsecs % 10));
+      for (i = 9; p[i - 1] == '0'; i--)
+         ;
+      p += i;
+   }
+   *p++ = 'Z';
+   *p = '\0';
+
+   if ((size_t)(p - tmpbuf) >= bufsiz) return LOG_RTERR (pctxt, RTERR_STROVFLW);
+   memcpy (buffer, tmpbuf, (size_t)(p - tmpbuf) + 1);
+
+   return 0;
+}
+
+int rtFormatUTCTime
+(OSCTXT *pctxt, OSINT64 secs, char* buffer, size_t bufsiz)
+{
+   char  tmpbuf[16];
+   char* p;
+
+   if (0 == buffer) return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   p = formatTime (tmpbuf, secs, TRUE, 1950, 2049);
+   if (0 == p) return LOG_RTERR (pctxt, RTERR_BADVALUE);
+
+   *p++ = 'Z';
+   *p = '\0';
+
+   if ((size_t)(p - tmpbuf) >= bufsiz) return LOG_RTERR (pctxt, RTERR_STROVFLW);
+   memcpy (buffer, tmpbuf, (size_t)(p - tmpbuf) + 1);
 
    return 0;
 }
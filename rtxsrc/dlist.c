@@ -69,6 +69,39 @@ OSRTDListNode* rtxDListAppendNode (OSRTDList* pList, OSRTDListNode* pListNode)
    return pListNode;
 }
 
+OSRTDListNode* rtxDListAllocNodesAndData
+(OSCTXT* pctxt, OSRTDList* pList, size_t count, size_t elemSize)
+{
+   OSRTDListNode* pFirstNode;
+   OSRTDListNode* pListNode;
+   OSOCTET* pmem;
+   size_t stride, i;
+
+   if (count == 0) return 0;
+
+   /* Each entry is a node immediately followed by its data item, as with */
+   /* rtxDListAllocNodeAndData.  A leading pad ensures no node or data    */
+   /* pointer coincides with the block address, so rtxDListFreeAll and    */
+   /* friends cannot release the shared block from under the list.        */
+
+   stride = OSRTDLISTNODESIZE + ((elemSize + 7) & (~7));
+   if (count > (((size_t)-1) - OSRTDLISTNODESIZE) / stride) return 0;
+
+   pmem = (OSOCTET*) rtxMemAllocZ
+      (pctxt, OSRTDLISTNODESIZE + (count * stride));
+   if (0 == pmem) return 0;
+
+   pFirstNode = (OSRTDListNode*) (pmem + OSRTDLISTNODESIZE);
+
+   for (i = 0, pmem += OSRTDLISTNODESIZE; i < count; i++, pmem += stride) {
+      pListNode = (OSRTDListNode*) pmem;
+      pListNode->data = (void*) (pmem + OSRTDLISTNODESIZE);
+      rtxDListAppendNode (pList, pListNode);
+   }
+
+   return pFirstNode;
+}
+
 /* Free all nodes, but not the data */
 void rtxDListFreeNodes (OSCTXT* pctxt, OSRTDList* pList)
 {
@@ -0,0 +1,309 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "rtxsrc/rtxEnum.h"
+
+/* Number of hash seeds tried, and the largest displacement tried for   */
+/* one bucket, before building the name index fails.                    */
+
+#define OSRT_K_ENUMSEEDS        16
+#define OSRT_K_ENUMMAXDISPLACE  (1UL << 20)
+
+/* Seeded FNV-1a hash of a name */
+
+static OSUINT32 hashName
+(const OSUTF8CHAR* name, size_t len, OSUINT32 seed)
+{
+   OSUINT32 hash = 2166136261u ^ seed;
+   size_t i;
+
+   for (i = 0; i < len; i++) {
+      hash = (hash ^ name[i]) * 16777619u;
+   }
+
+   return hash;
+}
+
+/* Slot of a name with the given hash and bucket displacement.  As in   */
+/* the CHD algorithm, the displacement d stands for the pair            */
+/* (d / m, d % m), so that every slot can be reached.                   */
+
+static OSUINT32 nameSlot (OSUINT32 hash, OSUINT32 d, OSUINT32 m)
+{
+   OSUINT32 f1, f2;
+
+   hash ^= hash >> 16;
+   hash *= 0x85EBCA6Bu;
+   hash ^= hash >> 13;
+   f1 = hash % m;
+   hash *= 0xC2B2AE35u;
+   hash ^= hash >> 16;
+   f2 = hash % m;
+
+   return (f1 + (OSUINT32)(((OSUINT64)(d / m) * f2) % m) + (d % m)) % m;
+}
+
+static OSUINT32 valueSlot (OSINT32 value, OSUINT32 mask)
+{
+   OSUINT32 hash = (OSUINT32)value * 0x9E3779B1u;
+   return (hash ^ (hash >> 16)) & mask;
+}
+
+static OSBOOL namesEqual (const OSEnumItem* pItem1, const OSEnumItem* pItem2)
+{
+   return (OSBOOL)(pItem1->namelen == pItem2->namelen &&
+      0 == memcmp (pItem1->name, pItem2->name, pItem1->namelen));
+}
+
+/* Build the minimal perfect hash of the names.  The names are hashed   */
+/* into buckets, and the buckets are placed largest first, each with    */
+/* the first displacement that puts all of its names into free slots.   */
+
+static int placeNames
+(OSCTXT* pctxt, OSEnumIndex* pIndex, OSUINT32* displace, OSUINT16* nameSlots)
+{
+   const OSEnumItem* table = pIndex->enumTable;
+   OSUINT32  n = pIndex->nnameSlots, r = pIndex->nbuckets;
+   OSUINT32  limit = OSRTMIN (n * n, OSRT_K_ENUMMAXDISPLACE);
+   OSUINT32  seed, i, j, b, k, c, t, d, s, nb, maxSize;
+   OSUINT32  *hashes, *slots;
+   OSUINT16  *next, *heads, *sizes, *order;
+   OSOCTET*  work;
+
+   work = (OSOCTET*) rtxMemAlloc
+      (pctxt, (2 * n * sizeof(OSUINT32)) + ((n + (3 * r)) * sizeof(OSUINT16)));
+   if (0 == work) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+   hashes = (OSUINT32*) work;
+   slots = hashes + n;
+   next = (OSUINT16*) (slots + n);
+   heads = next + n;
+   sizes = heads + r;
+   order = sizes + r;
+
+   for (seed = 0; seed < OSRT_K_ENUMSEEDS; seed++) {
+      memset (heads, 0, r * sizeof(OSUINT16));
+      memset (sizes, 0, r * sizeof(OSUINT16));
+      memset (displace, 0, r * sizeof(OSUINT32));
+      memset (nameSlots, 0, n * sizeof(OSUINT16));
+
+      /* Distribute the rows over the buckets; a repeated name is left  */
+      /* to its first row.                                              */
+
+      maxSize = 0;
+      for (i = 0; i < n; i++) {
+         hashes[i] = hashName (table[i].name, table[i].namelen, seed);
+         b = hashes[i] % r;
+
+         for (j = heads[b]; j != 0; j = next[j - 1]) {
+            if (hashes[j - 1] == hashes[i] &&
+                namesEqual (&table[j - 1], &table[i])) break;
+         }
+         if (j != 0) continue;
+
+         next[i] = heads[b];
+         heads[b] = (OSUINT16)(i + 1);
+         if (++sizes[b] > maxSize) maxSize = sizes[b];
+      }
+
+      for (s = maxSize, nb = 0; s > 0; s--) {
+         for (b = 0; b < r; b++) {
+            if (sizes[b] == s) order[nb++] = (OSUINT16)b;
+         }
+      }
+
+      for (k = 0; k < nb; k++) {
+         b = order[k];
+
+         for (d = 0; d < limit; d++) {
+            for (j = heads[b], c = 0; j != 0; j = next[j - 1], c++) {
+               s = nameSlot (hashes[j - 1], d, n);
+               if (nameSlots[s] != 0) break;
+               for (t = 0; t < c && slots[t] != s; t++) ;
+               if (t < c) break;
+               slots[c] = s;
+            }
+            if (j == 0) break;
+         }
+         if (d == limit) break;  /* try another seed */
+
+         for (j = heads[b], c = 0; j != 0; j = next[j - 1], c++) {
+            nameSlots[slots[c]] = (OSUINT16)j;
+         }
+         displace[b] = d;
+      }
+
+      if (k == nb) {
+         pIndex->seed = seed;
+         rtxMemFreePtr (pctxt, work);
+         return 0;
+      }
+   }
+
+   rtxMemFreePtr (pctxt, work);
+   return LOG_RTERR (pctxt, RTERR_BADVALUE);
+}
+
+static void placeValues (OSEnumIndex* pIndex, OSUINT16 numRows,
+                         OSUINT16* valueSlots)
+{
+   const OSEnumItem* table = pIndex->enumTable;
+   OSUINT32 mask = pIndex->nvalueSlots - 1, i, s;
+
+   for (i = 0; i < numRows; i++) {
+      if (pIndex->denseValues) {
+         s = (OSUINT32)table[i].value - (OSUINT32)pIndex->minValue;
+      }
+      else {
+         s = valueSlot (table[i].value, mask);
+         while (valueSlots[s] != 0 &&
+                table[valueSlots[s] - 1].value != table[i].value)
+            s = (s + 1) & mask;
+      }
+
+      /* A repeated value is left to its first row */
+      if (valueSlots[s] == 0) valueSlots[s] = (OSUINT16)(i + 1);
+   }
+}
+
+int rtxEnumIndexInit
+(OSCTXT* pctxt, OSEnumIndex* pIndex, const OSEnumItem enumTable[],
+ OSUINT16 enumTableSize)
+{
+   OSUINT32  n = enumTableSize, i;
+   OSINT32   maxValue;
+   OSUINT32* displace;
+   OSUINT16* nameSlots;
+   int stat;
+
+   if (0 == pctxt || 0 == pIndex) return RTERR_NULLPTR;
+
+   memset (pIndex, 0, sizeof(OSEnumIndex));
+   pIndex->pctxt = pctxt;
+   pIndex->enumTable = enumTable;
+
+   if (n == 0) return 0;
+   if (0 == enumTable) return LOG_RTERR (pctxt, RTERR_NULLPTR);
+
+   /* Values are indexed directly unless they are sparse */
+
+   pIndex->minValue = maxValue = enumTable[0].value;
+   for (i = 1; i < n; i++) {
+      if (enumTable[i].value < pIndex->minValue)
+         pIndex->minValue = enumTable[i].value;
+      else if (enumTable[i].value > maxValue)
+         maxValue = enumTable[i].value;
+   }
+
+   if ((OSUINT32)maxValue - (OSUINT32)pIndex->minValue < (2 * n) + 16) {
+      pIndex->denseValues = TRUE;
+      pIndex->nvalueSlots =
+         (OSUINT32)maxValue - (OSUINT32)pIndex->minValue + 1;
+   }
+   else {
+      pIndex->nvalueSlots = 16;
+      while (pIndex->nvalueSlots < 2 * n) pIndex->nvalueSlots *= 2;
+   }
+
+   pIndex->nnameSlots = n;
+   pIndex->nbuckets = (n + 1) / 2;
+
+   /* All arrays are held in one block starting with the displacements */
+
+   displace = (OSUINT32*) rtxMemAllocZ (pctxt,
+      (pIndex->nbuckets * sizeof(OSUINT32)) +
+      ((n + pIndex->nvalueSlots) * sizeof(OSUINT16)));
+   if (0 == displace) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+   nameSlots = (OSUINT16*) (displace + pIndex->nbuckets);
+
+   stat = placeNames (pctxt, pIndex, displace, nameSlots);
+   if (stat != 0) {
+      rtxMemFreePtr (pctxt, displace);
+      pIndex->nnameSlots = pIndex->nvalueSlots = 0;
+      return LOG_RTERR (pctxt, stat);
+   }
+
+   placeValues (pIndex, enumTableSize, nameSlots + n);
+
+   pIndex->displace = displace;
+   pIndex->nameSlots = nameSlots;
+   pIndex->valueSlots = nameSlots + n;
+
+   return 0;
+}
+
+void rtxEnumIndexFree (OSEnumIndex* pIndex)
+{
+   if (0 == pIndex || 0 == pIndex->pctxt) return;
+
+   rtxMemFreePtr (pIndex->pctxt, pIndex->displace);
+
+   memset (pIndex, 0, sizeof(OSEnumIndex));
+}
+
+OSINT32 rtxEnumIndexLookup
+(const OSEnumIndex* pIndex, const OSUTF8CHAR* strValue, size_t strValueSize)
+{
+   const OSEnumItem* pItem;
+   OSUINT32 hash, row;
+
+   if (0 == pIndex || pIndex->nnameSlots == 0 || 0 == strValue)
+      return RTERR_INVENUM;
+
+   if (strValueSize == (size_t)-1) {
+      strValueSize = rtxUTF8LenBytes (strValue);
+   }
+
+   hash = hashName (strValue, strValueSize, pIndex->seed);
+   row = pIndex->nameSlots[nameSlot (hash,
+      pIndex->displace[hash % pIndex->nbuckets], pIndex->nnameSlots)];
+
+   /* The slot holds the only row the name can match */
+
+   if (row != 0) {
+      pItem = &pIndex->enumTable[row - 1];
+      if ((size_t)pItem->namelen == strValueSize &&
+          0 == memcmp (pItem->name, strValue, strValueSize))
+         return (OSINT32)(row - 1);
+   }
+
+   return RTERR_INVENUM;
+}
+
+OSINT32 rtxEnumIndexLookupByValue (const OSEnumIndex* pIndex, OSINT32 value)
+{
+   OSUINT32 s, row;
+
+   if (0 == pIndex || pIndex->nvalueSlots == 0) return RTERR_INVENUM;
+
+   if (pIndex->denseValues) {
+      s = (OSUINT32)value - (OSUINT32)pIndex->minValue;
+      row = (s < pIndex->nvalueSlots) ? pIndex->valueSlots[s] : 0;
+   }
+   else {
+      OSUINT32 mask = pIndex->nvalueSlots - 1;
+
+      s = valueSlot (value, mask);
+      while ((row = pIndex->valueSlots[s]) != 0 &&
+             pIndex->enumTable[row - 1].value != value)
+         s = (s + 1) & mask;
+   }
+
+   return (row != 0) ? (OSINT32)(row - 1) : RTERR_INVENUM;
+}
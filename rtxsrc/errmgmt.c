@@ -98,6 +98,23 @@ int rtxErrAddStrParm (OSCTXT* pctxt, const char* errprm_p)
    else return FALSE;
 }
 
+/* Add a deferred parameter to an error message.  The parameter is    */
+/* formatted when the error text is built.                              */
+
+int rtxErrAddLazyParm
+(OSCTXT* pctxt, ASN1ErrParmFmtFunc fmtFunc, OSUINT32 value)
+{
+   ASN1ErrInfo* pErrInfo = &pctxt->errInfo;
+   if (pErrInfo->parmcnt < ASN_K_MAXERRP) {
+      pErrInfo->parms[pErrInfo->parmcnt] = 0;
+      pErrInfo->lazyParms[pErrInfo->parmcnt].fmtFunc = fmtFunc;
+      pErrInfo->lazyParms[pErrInfo->parmcnt].value = value;
+      pErrInfo->parmcnt++;
+      return TRUE;
+   }
+   else return FALSE;
+}
+
 /* Add an element name parameter (not supported in OO version) */
 
 OSBOOL rtxErrAddElemNameParm (OSCTXT* pctxt)
@@ -145,6 +162,8 @@ void rtxErrFreeParms (OSCTXT* pctxt)
    }
    pErrInfo->parmcnt = 0;
    pErrInfo->status = 0;
+   pErrInfo->first.module = 0;
+   pErrInfo->first.lineno = 0;
 }
 
 /* Reset error */
@@ -156,12 +175,15 @@ int rtxErrReset (OSCTXT* pctxt)
    return 0;
 }
 
-/* Format error message */
+/* Format error message.  Deferred parameters are formatted here and   */
+/* the text is truncated if it does not fit in the buffer.              */
 
-static char* errFmtMsg (ASN1ErrInfo* pErrInfo, char* bufp)
+static char* errFmtMsg (ASN1ErrInfo* pErrInfo, char* bufp, size_t bufsiz)
 {
    const char* tp;
-   size_t i, j, pcnt;
+   const char* parm;
+   char lbuf[64];
+   size_t i, j, pcnt, len;
 
    if (pErrInfo->status < 0)
    {
@@ -174,16 +196,28 @@ static char* errFmtMsg (ASN1ErrInfo* pErrInfo, char* bufp)
          j  = pcnt = 0;
          tp = g_status_text[i];
 
-         while (*tp)
+         while (*tp && j < bufsiz - 1)
          {
             if (*tp == '%' && *(tp+1) == 's')
             {
                /* Plug in error parameter */
 
-               if (pcnt < (size_t)pErrInfo->parmcnt && pErrInfo->parms[pcnt])
+               parm = 0;
+               if (pcnt < (size_t)pErrInfo->parmcnt) {
+                  parm = pErrInfo->parms[pcnt];
+                  if (0 == parm && 0 != pErrInfo->lazyParms[pcnt].fmtFunc) {
+                     parm = pErrInfo->lazyParms[pcnt].fmtFunc
+                        (pErrInfo->lazyParms[pcnt].value, lbuf, sizeof(lbuf));
+                  }
+               }
+
+               if (parm)
                {
-                  strcpy (&bufp[j], pErrInfo->parms[pcnt]);
-                  j += strlen (pErrInfo->parms[pcnt++]);
+                  len = strlen (parm);
+                  if (len > bufsiz - 1 - j) len = bufsiz - 1 - j;
+                  memcpy (&bufp[j], parm, len);
+                  j += len;
+                  pcnt++;
                }
                else
                   bufp[j++] = '?';
@@ -212,19 +246,39 @@ char* rtxErrGetText (OSCTXT* pctxt)
 {
    char lbuf[500];
    ASN1ErrInfo* pErrInfo = &pctxt->errInfo;
-   char* pBuf = (char*) rtxMemAlloc (pctxt,
-      (sizeof(lbuf) + 100 * (2 + pErrInfo->stkx)) * sizeof(char));
+   size_t bufsiz;
+   int i;
+   char* pBuf;
 
-   sprintf (pBuf, "ASN.1 ERROR: Status %d\n", pErrInfo->status);
-   sprintf (lbuf, "%s\nStack trace:", errFmtMsg (pErrInfo, lbuf));
-   strcat(pBuf, lbuf);
+   errFmtMsg (pErrInfo, lbuf, sizeof(lbuf));
 
+   /* Location text is "  Module: <name>, Line <n>\n" */
+
+   bufsiz = strlen (lbuf) + 80;
+   if (0 != pErrInfo->first.module) {
+      bufsiz += strlen (pErrInfo->first.module) + 40;
+   }
+   for (i = 0; i < pErrInfo->stkx; i++) {
+      bufsiz += strlen (pErrInfo->stack[i].module) + 40;
+   }
+
+   pBuf = (char*) rtxMemAlloc (pctxt, bufsiz * sizeof(char));
+   if (0 == pBuf) return 0;
+
+   sprintf (pBuf, "ASN.1 ERROR: Status %d\n%s\n", pErrInfo->status, lbuf);
+
+   if (0 != pErrInfo->first.module) {
+      sprintf (pBuf + strlen(pBuf), "Location:\n  Module: %s, Line %d\n",
+               pErrInfo->first.module, pErrInfo->first.lineno);
+   }
+   if (pErrInfo->stkx > 0) {
+      strcat (pBuf, "Stack trace:\n");
+   }
    while (pErrInfo->stkx > 0) {
       pErrInfo->stkx--;
-      sprintf (lbuf, "  Module: %s, Line %d\n",
+      sprintf (pBuf + strlen(pBuf), "  Module: %s, Line %d\n",
                pErrInfo->stack[pErrInfo->stkx].module,
                pErrInfo->stack[pErrInfo->stkx].lineno);
-      strcat(pBuf, lbuf);
    }
 
    rtxErrFreeParms (pctxt);
@@ -237,10 +291,16 @@ char* rtxErrGetText (OSCTXT* pctxt)
 void rtxErrPrint (OSCTXT* pctxt)
 {
    ASN1ErrInfo* pErrInfo = &pctxt->errInfo;
-   char lbuf[200];
+   char lbuf[500];
    printf ("ASN.1 ERROR: Status %d\n", pErrInfo->status);
-   printf ("%s\n", errFmtMsg (pErrInfo, lbuf));
-   printf ("Stack trace:");
+   printf ("%s\n", errFmtMsg (pErrInfo, lbuf, sizeof(lbuf)));
+   if (0 != pErrInfo->first.module) {
+      printf ("Location:\n  Module: %s, Line %d\n",
+              pErrInfo->first.module, pErrInfo->first.lineno);
+   }
+   if (pErrInfo->stkx > 0) {
+      printf ("Stack trace:\n");
+   }
    while (pErrInfo->stkx > 0) {
       pErrInfo->stkx--;
       printf ("  Module: %s, Line %d\n",
@@ -250,12 +310,28 @@ void rtxErrPrint (OSCTXT* pctxt)
    rtxErrFreeParms (pctxt);
 }
 
+/* Record an error.  The first error status is kept, with the location */
+/* that logged it, as it is propagated back to the caller; all text is */
+/* built when the error is retrieved or printed.  A frame for every    */
+/* call is only pushed in OSRT_ERRSTACK builds, so that errors which   */
+/* are expected and handled, such as the tag mismatch of an absent     */
+/* optional element, cost no more than a few stores.                   */
+
 int rtxErrSetData (OSCTXT* pctxt, int status, const char* module, int lno)
 {
    ASN1ErrInfo* pErrInfo = &pctxt->errInfo;
-   if (pErrInfo->status == 0) {
+   if (pErrInfo->status == 0 && status != 0) {
       pErrInfo->status = status;
+      pErrInfo->first.module = module;
+      pErrInfo->first.lineno = lno;
+   }
+#ifdef OSRT_ERRSTACK
+   if (status != 0 && pErrInfo->stkx < ASN_K_MAXERRSTK) {
+      pErrInfo->stack[pErrInfo->stkx].module = module;
+      pErrInfo->stack[pErrInfo->stkx].lineno = lno;
+      pErrInfo->stkx++;
    }
+#endif
    return status;
 }
 
@@ -146,6 +146,11 @@ void rtxMemFree (OSCTXT* pctxt)
       free (pPrevMemBlk->pmem);
       free (pPrevMemBlk);
    }
+
+   /* Leave an empty heap so the context can be reused after a reset */
+
+   pMemHeap->phead = pMemHeap->ptail = 0;
+   pMemHeap->count = 0;
 }
 
 void* rtxMemRealloc (OSCTXT* pctxt, void* pmem, size_t nbytes)
@@ -186,6 +191,39 @@ OSBOOL rtxMemHeapIsEmpty (OSCTXT* pctxt)
    return (OSBOOL)(0 == pMemHeap->count);
 }
 
+int rtxMemHeapTransfer (OSCTXT* pDestCtxt, OSCTXT* pSrcCtxt)
+{
+   OSMemHeap* pSrcHeap = (OSMemHeap*) pSrcCtxt->pMemHeap;
+   OSMemHeap* pDestHeap;
+
+   if (pSrcHeap == 0 || pSrcHeap->phead == 0) return 0;
+
+   if (pDestCtxt->pMemHeap == 0) {
+      pDestHeap = (OSMemHeap*) malloc (sizeof (OSMemHeap));
+      if (pDestHeap == NULL) return RTERR_NOMEM;
+
+      memset (pDestHeap, 0, sizeof (OSMemHeap));
+      pDestCtxt->pMemHeap = (void*) pDestHeap;
+   }
+   else pDestHeap = (OSMemHeap*) pDestCtxt->pMemHeap;
+
+   /* Append source block list to end of destination block list */
+
+   if (pDestHeap->ptail != NULL) {
+      pDestHeap->ptail->pnext = pSrcHeap->phead;
+   }
+   else {
+      pDestHeap->phead = pSrcHeap->phead;
+   }
+   pDestHeap->ptail = pSrcHeap->ptail;
+   pDestHeap->count += pSrcHeap->count;
+
+   pSrcHeap->phead = pSrcHeap->ptail = 0;
+   pSrcHeap->count = 0;
+
+   return 0;
+}
+
 void rtxMemFreeOpenSeqExt (OSCTXT* pctxt, OSRTDList* pElemList)
 {
    if (!rtxMemHeapIsEmpty (pctxt)) {
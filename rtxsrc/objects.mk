@@ -1,11 +1,15 @@
 RTXOBJECTS = \
 $(OBJDIR)$(PS)base64$(OBJ) \
+$(OBJDIR)$(PS)bcd$(OBJ) \
 $(OBJDIR)$(PS)charstr$(OBJ) \
 $(OBJDIR)$(PS)context$(OBJ) \
 $(OBJDIR)$(PS)datetime$(OBJ) \
 $(OBJDIR)$(PS)dlist$(OBJ) \
+$(OBJDIR)$(PS)enumidx$(OBJ) \
 $(OBJDIR)$(PS)errmgmt$(OBJ) \
 $(OBJDIR)$(PS)memmgmt$(OBJ) \
+$(OBJDIR)$(PS)oidtable$(OBJ) \
 $(OBJDIR)$(PS)print$(OBJ) \
+$(OBJDIR)$(PS)thread$(OBJ) \
 $(OBJDIR)$(PS)utf8str$(OBJ) \
 $(OBJDIR)$(PS)utils$(OBJ)
@@ -0,0 +1,234 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <string.h>
+#include "rtxsrc/rtxOIDTable.h"
+
+/* Initial number of hash buckets.  The bucket array is doubled when   */
+/* it becomes half full, so a search rarely probes more than a few.    */
+
+#define OSRT_K_OIDTABBUCKETS 64
+
+/* FNV-1a hash of the contents octets */
+
+static OSUINT32 hashOID (const OSOCTET* data, OSUINT32 numocts)
+{
+   OSUINT32 i, hash = 2166136261u;
+
+   for (i = 0; i < numocts; i++) {
+      hash = (hash ^ data[i]) * 16777619u;
+   }
+
+   return hash;
+}
+
+/* Find the bucket holding the given OID or the empty bucket where it   */
+/* would be inserted.                                                   */
+
+static OSUINT32 findBucket
+(const OSRTOIDTable* pTable, const OSOCTET* data, OSUINT32 numocts,
+ OSUINT32 hash)
+{
+   OSUINT32 mask = pTable->nbuckets - 1;
+   OSUINT32 i = hash & mask;
+   OSUINT32 handle;
+
+   while ((handle = pTable->buckets[i]) != 0) {
+      const OSRTOIDTableEntry* pEntry = &pTable->entries[handle - 1];
+
+      if (pEntry->hash == hash && pEntry->numocts == numocts &&
+          0 == memcmp (pEntry->data, data, numocts))
+         break;
+
+      i = (i + 1) & mask;
+   }
+
+   return i;
+}
+
+static int growBuckets (OSRTOIDTable* pTable)
+{
+   OSUINT32  nbuckets = pTable->nbuckets * 2;
+   OSUINT32* buckets = (OSUINT32*)
+      rtxMemAllocZ (pTable->pctxt, nbuckets * sizeof(OSUINT32));
+   OSUINT32  i, j;
+
+   if (0 == buckets) return LOG_RTERR (pTable->pctxt, RTERR_NOMEM);
+
+   for (i = 0; i < pTable->count; i++) {
+      j = pTable->entries[i].hash & (nbuckets - 1);
+      while (buckets[j] != 0) j = (j + 1) & (nbuckets - 1);
+      buckets[j] = i + 1;
+   }
+
+   rtxMemFreePtr (pTable->pctxt, pTable->buckets);
+   pTable->buckets = buckets;
+   pTable->nbuckets = nbuckets;
+
+   return 0;
+}
+
+int rtxOIDTableInit (OSCTXT* pctxt, OSRTOIDTable* pTable)
+{
+   if (0 == pctxt || 0 == pTable) return RTERR_NULLPTR;
+
+   memset (pTable, 0, sizeof(OSRTOIDTable));
+   pTable->pctxt = pctxt;
+
+   pTable->buckets = (OSUINT32*)
+      rtxMemAllocZ (pctxt, OSRT_K_OIDTABBUCKETS * sizeof(OSUINT32));
+
+   if (0 == pTable->buckets) return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+   pTable->nbuckets = OSRT_K_OIDTABBUCKETS;
+
+   return 0;
+}
+
+void rtxOIDTableFree (OSRTOIDTable* pTable)
+{
+   OSUINT32 i;
+
+   if (0 == pTable || 0 == pTable->pctxt) return;
+
+   for (i = 0; i < pTable->count; i++) {
+      rtxMemFreePtr (pTable->pctxt, pTable->entries[i].data);
+   }
+   rtxMemFreePtr (pTable->pctxt, pTable->entries);
+   rtxMemFreePtr (pTable->pctxt, pTable->buckets);
+
+   memset (pTable, 0, sizeof(OSRTOIDTable));
+}
+
+int rtxOIDTableAdd
+(OSRTOIDTable* pTable, const OSOCTET* data, OSUINT32 numocts,
+ OSUINT32* pHandle)
+{
+   OSRTOIDTableEntry* pEntry;
+   OSOCTET* pdata;
+   OSUINT32 hash, i;
+   int stat;
+
+   if (0 == pTable || 0 == pTable->buckets || 0 == pHandle)
+      return RTERR_NULLPTR;
+
+   if (0 == data || 0 == numocts)
+      return LOG_RTERR (pTable->pctxt, RTERR_INVOBJID);
+
+   hash = hashOID (data, numocts);
+   i = findBucket (pTable, data, numocts, hash);
+
+   if (pTable->buckets[i] != 0) {
+      *pHandle = pTable->buckets[i];
+      return 0;
+   }
+
+   /* Add a new entry */
+
+   if (pTable->count == pTable->capacity) {
+      OSUINT32 capacity = (pTable->capacity == 0) ?
+         OSRT_K_OIDTABBUCKETS / 2 : pTable->capacity * 2;
+
+      pEntry = (OSRTOIDTableEntry*) ((0 == pTable->entries) ?
+         rtxMemAlloc (pTable->pctxt, capacity * sizeof(OSRTOIDTableEntry)) :
+         rtxMemRealloc (pTable->pctxt, pTable->entries,
+                        capacity * sizeof(OSRTOIDTableEntry)));
+
+      if (0 == pEntry) return LOG_RTERR (pTable->pctxt, RTERR_NOMEM);
+
+      pTable->entries = pEntry;
+      pTable->capacity = capacity;
+   }
+
+   pdata = (OSOCTET*) rtxMemAlloc (pTable->pctxt, numocts);
+   if (0 == pdata) return LOG_RTERR (pTable->pctxt, RTERR_NOMEM);
+   memcpy (pdata, data, numocts);
+
+   pEntry = &pTable->entries[pTable->count++];
+   pEntry->data = pdata;
+   pEntry->numocts = numocts;
+   pEntry->hash = hash;
+
+   pTable->buckets[i] = pTable->count;
+   *pHandle = pTable->count;
+
+   /* Keep the load factor at or below one half */
+
+   if (pTable->count * 2 > pTable->nbuckets) {
+      stat = growBuckets (pTable);
+      if (stat != 0) return LOG_RTERR (pTable->pctxt, stat);
+   }
+
+   return 0;
+}
+
+int rtxOIDTableAddObjId
+(OSRTOIDTable* pTable, const ASN1OBJID* pOID, OSUINT32* pHandle)
+{
+   OSOCTET  buf[ASN_K_MAXSUBIDS * 5];
+   OSUINT32 subid, numocts = 0, i;
+   int      shift;
+
+   if (0 == pTable || 0 == pOID) return RTERR_NULLPTR;
+
+   /* Validate OID by applying ASN.1 rules (see xe_objid).  The second */
+   /* arc under 2 must also leave room for the 80 added to it.          */
+
+   if (pOID->numids < 2 || pOID->numids > ASN_K_MAXSUBIDS ||
+       pOID->subid[0] > 2 || (pOID->subid[0] != 2 && pOID->subid[1] > 39) ||
+       pOID->subid[1] > OSUINT32_MAX - 80)
+      return LOG_RTERR (pTable->pctxt, RTERR_INVOBJID);
+
+   /* Encode subidentifiers; the first two are combined into one */
+
+   for (i = 1; i < pOID->numids; i++) {
+      subid = (i == 1) ?
+         (pOID->subid[0] * 40) + pOID->subid[1] : pOID->subid[i];
+
+      for (shift = 28; shift > 0 && (subid >> shift) == 0; shift -= 7)
+         ;
+      for (; shift > 0; shift -= 7) {
+         buf[numocts++] = (OSOCTET) (0x80 | ((subid >> shift) & 0x7F));
+      }
+      buf[numocts++] = (OSOCTET) (subid & 0x7F);
+   }
+
+   return rtxOIDTableAdd (pTable, buf, numocts, pHandle);
+}
+
+OSUINT32 rtxOIDTableFind
+(const OSRTOIDTable* pTable, const OSOCTET* data, OSUINT32 numocts)
+{
+   if (0 == pTable || 0 == pTable->buckets || 0 == data || 0 == numocts)
+      return 0;
+
+   return pTable->buckets
+      [findBucket (pTable, data, numocts, hashOID (data, numocts))];
+}
+
+int rtxOIDTableGet
+(const OSRTOIDTable* pTable, OSUINT32 handle, ASN1EncOID* pOID)
+{
+   if (0 == pTable || 0 == pOID) return RTERR_NULLPTR;
+   if (handle == 0 || handle > pTable->count) return RTERR_INVPARAM;
+
+   pOID->numocts = pTable->entries[handle - 1].numocts;
+   pOID->data = pTable->entries[handle - 1].data;
+   pOID->handle = handle;
+
+   return 0;
+}
@@ -21,223 +21,889 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include <ctype.h>
 #include "rtsrc/rtPrint.h"
 
 #ifndef BITSTR_BYTES_IN_LINE
 #define BITSTR_BYTES_IN_LINE 16
 #endif
 
-void rtxPrintBoolean (const char* name, OSBOOL value)
+/* Each thread has its own current and default print sink where the     */
+/* compiler supports thread-local storage.                              */
+
+#if defined(_MSC_VER)
+#define OSRTPRINT_TLS __declspec(thread)
+#elif defined(__GNUC__)
+#define OSRTPRINT_TLS __thread
+#else
+#define OSRTPRINT_TLS
+#endif
+
+static OSRTPRINT_TLS OSRTPrintSink* g_pSink = 0;
+static OSRTPRINT_TLS OSRTPrintSink  g_stdoutSink;
+static OSRTPRINT_TLS char           g_stdoutBuf[OSRTPRINT_BUFSIZE];
+
+static const char hexDigits[] = "0123456789abcdef";
+static const char hexDigitsUC[] = "0123456789ABCDEF";
+
+static const char digitPairs[] =
+   "00010203040506070809101112131415161718192021222324252627282930313233"
+   "34353637383940414243444546474849505152535455565758596061626364656667"
+   "6869707172737475767778798081828384858687888990919293949596979899";
+
+#define IS_PRINTABLE(c) ((c) >= 0x20 && (c) < 0x7F)
+#define IS_JSON(pSink)  (((pSink)->flags & OSRTPRINT_JSON) != 0)
+
+/* Escapes of ASCII characters in JSON strings: 0 if the character is   */
+/* copied, 'u' if it is written as a \u00XX escape and otherwise the    */
+/* character following the backslash.                                   */
+
+static const char jsonEscapes[128] = {
+   'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+   'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+   'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+   'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+   0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+   0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'u'
+} ;
+
+static OSRTPrintSink* getSink (void)
 {
-   printf ("%s = %s\n", name, value ? "true" : "false");
+   if (0 != g_pSink) return g_pSink;
+
+   if (0 == g_stdoutSink.data) {
+      g_stdoutSink.data = g_stdoutBuf;
+      g_stdoutSink.capacity = sizeof(g_stdoutBuf);
+      g_stdoutSink.fp = stdout;
+      g_stdoutSink.flags = OSRTPRINT_AUTOFLUSH;
+   }
+   return &g_stdoutSink;
 }
 
-void rtxPrintInteger (const char* name, OSINT32 value)
+static void sinkWriteFile
+(OSRTPrintSink* pSink, const char* data, OSSIZE nbytes)
 {
-   printf ("%s = %d\n", name, value);
+   if (fwrite (data, 1, nbytes, pSink->fp) != nbytes && pSink->status == 0)
+      pSink->status = RTERR_WRITEERR;
 }
 
-void rtxPrintUnsigned (const char* name, OSUINT32 value)
+/* Grow the buffer of a sink to hold nbytes more and a null terminator */
+
+static OSBOOL sinkGrow (OSRTPrintSink* pSink, OSSIZE nbytes)
 {
-   printf ("%s = %u\n", name, value);
+   OSSIZE capacity = pSink->capacity * 2;
+   char*  data;
+
+   if (pSink->status != 0) return FALSE;
+
+   if (capacity < pSink->length + nbytes + 1)
+      capacity = pSink->length + nbytes + 1;
+
+   data = (char*) realloc (pSink->data, capacity);
+   if (0 == data) {
+      pSink->status = RTERR_NOMEM;
+      return FALSE;
+   }
+   pSink->data = data;
+   pSink->capacity = capacity;
+
+   return TRUE;
 }
 
-void rtxPrintCharStr (const char* name, const char* cstring)
+/* Forget the member names of the open JSON objects once the line      */
+/* being built is no longer in the buffer.                              */
+
+static void jsonForgetNames (OSRTPrintSink* pSink)
 {
-   printf ("%s = '%s'\n", name,
-      (cstring == 0) ? "(null)" : cstring);
+   int i;
+   for (i = 0; i < OSRTPRINT_JSONDEPTH; i++) {
+      pSink->jsonLevels[i].keyLen = 0;
+   }
+   pSink->lineStart = 0;
 }
 
-void rtxPrintUTF8CharStr (const char* name, const OSUTF8CHAR* cstring)
+/* Make room for nbytes more bytes and a null terminator.  A memory     */
+/* sink grows its buffer.  A sink for a file writes out its buffer,     */
+/* except that a JSON sink keeps the line being built and grows the     */
+/* buffer if that line does not leave room.  Only the fixed buffer of   */
+/* the default sink cannot grow; it then writes out the line as well.   */
+/* Returns FALSE if there is still no room.                             */
+
+static OSBOOL sinkMakeRoom (OSRTPrintSink* pSink, OSSIZE nbytes)
 {
-   printf ("%s = '%s'\n", name,
-      (cstring == 0) ? "(null)" : (const char*)cstring);
+   OSSIZE keep;
+   int i;
+
+   if (0 == pSink->fp) return sinkGrow (pSink, nbytes);
+
+   keep = (IS_JSON (pSink)) ? pSink->length - pSink->lineStart : 0;
+
+   sinkWriteFile (pSink, pSink->data, pSink->length - keep);
+   if (keep > 0) {
+      memmove (pSink->data, pSink->data + pSink->lineStart, keep);
+      for (i = 0; i < OSRTPRINT_JSONDEPTH; i++) {
+         pSink->jsonLevels[i].keyOff -= pSink->lineStart;
+      }
+   }
+   pSink->length = keep;
+   pSink->lineStart = 0;
+
+   if (pSink->capacity - keep > nbytes) return TRUE;
+
+   if (IS_JSON (pSink) && pSink->data != g_stdoutBuf)
+      return sinkGrow (pSink, nbytes);
+
+   if (keep > 0) {
+      sinkWriteFile (pSink, pSink->data, keep);
+      pSink->length = 0;
+      jsonForgetNames (pSink);
+   }
+
+   return (OSBOOL)(pSink->capacity > nbytes);
 }
 
-void rtxPrintUnicodeCharStr
-(const char* name, const OSUNICHAR* str, int nchars)
+/* Return space for nbytes (at most OSRTPRINT_MINBUFSIZE) of output, or */
+/* null if the sink failed.  The caller adds the bytes to the length.   */
+
+static char* sinkReserve (OSRTPrintSink* pSink, OSSIZE nbytes)
 {
-   int i;
-   if (0 == str) return;
-   if (nchars < 0) {
-      nchars = 0;
-      while (str[nchars] != 0) nchars++;
+   if (pSink->capacity - pSink->length <= nbytes &&
+       !sinkMakeRoom (pSink, nbytes)) return 0;
+
+   return pSink->data + pSink->length;
+}
+
+static void sinkWrite (OSRTPrintSink* pSink, const char* data, OSSIZE nbytes)
+{
+   if (pSink->capacity - pSink->length <= nbytes &&
+       !sinkMakeRoom (pSink, nbytes)) {
+      /* Too large for the buffer of a file sink */
+      if (0 != pSink->fp && pSink->length == 0)
+         sinkWriteFile (pSink, data, nbytes);
+      return;
    }
-   printf ("%s = '", name);
-   for (i = 0; i < nchars; i++) {
-      if (isprint (str[i]))
-         putc (str[i], stdout);
-      else
-         printf ("0x%04x", str[i]);
+   memcpy (pSink->data + pSink->length, data, nbytes);
+   pSink->length += nbytes;
+}
+
+static void sinkPuts (OSRTPrintSink* pSink, const char* str)
+{
+   sinkWrite (pSink, str, strlen (str));
+}
+
+static void sinkPutc (OSRTPrintSink* pSink, char c)
+{
+   char* p = sinkReserve (pSink, 1);
+   if (0 != p) {
+      *p = c;
+      pSink->length++;
    }
-   printf ("'\n");
 }
 
-static char* strTrim (char *s)
+static void sinkPutSpaces (OSRTPrintSink* pSink, OSSIZE count)
 {
-   int i = (int)OSCRTLSTRLEN(s) - 1;
-   while (i >= 0 && s[i] == ' ') i--;
-   s[i+1] = '\0';
-   return (s);
+   char*  p;
+   OSSIZE n;
+
+   for (; count > 0; count -= n) {
+      n = OSRTMIN (count, OSRTPRINT_MINBUFSIZE);
+      if (0 == (p = sinkReserve (pSink, n))) return;
+      memset (p, ' ', n);
+      pSink->length += n;
+   }
 }
 
-static int rtxByteToHexChar (OSOCTET byte, char* buf, OSSIZE bufsize)
+/* Decimal digits are produced two at a time from the digit pair table */
+
+static void sinkPutUInt (OSRTPrintSink* pSink, OSUINT64 value)
 {
-   OSUINT32 tmpval = byte;
-   if (bufsize < 3) return RTERR_BUFOVFLW;
-   tmpval >>= 4;
-   buf[0] = (char)((tmpval <= 9) ? tmpval + '0' : tmpval - 10 + 'a');
-   tmpval = byte & 0x0F;  /* shave off MS nibble */
-   buf[1] = (char)((tmpval <= 9) ? tmpval + '0' : tmpval - 10 + 'a');
-   buf[2] = '\0';
-   return 0;
+   char buf[20], *p = buf + sizeof(buf);
+   unsigned d;
+
+   while (value >= 100) {
+      d = (unsigned)(value % 100) * 2;
+      value /= 100;
+      *--p = digitPairs[d + 1];
+      *--p = digitPairs[d];
+   }
+   if (value >= 10) {
+      d = (unsigned)value * 2;
+      *--p = digitPairs[d + 1];
+      *--p = digitPairs[d];
+   }
+   else *--p = (char)('0' + value);
+
+   sinkWrite (pSink, p, (OSSIZE)(buf + sizeof(buf) - p));
 }
 
-static void rtxHexDumpToFileEx
-(FILE* fp, const OSOCTET* data, OSSIZE numocts, int bytesPerUnit)
+static void sinkPutInt (OSRTPrintSink* pSink, OSINT32 value)
 {
-   OSSIZE   i;
-   OSUINT32 val;
-   OSOCTET  b, dumpstr = 1;
-   char     hexstr[49], ascstr[17], buf[20], *pbuf;
-   int      k, unitsPerLine = 16 / bytesPerUnit, ai, shift;
+   if (value < 0) {
+      sinkPutc (pSink, '-');
+      sinkPutUInt (pSink, (OSUINT32)0 - (OSUINT32)value);
+   }
+   else sinkPutUInt (pSink, (OSUINT32)value);
+}
 
-   memset (hexstr, ' ', 48); hexstr[48] = '\0';
-   memset (ascstr, ' ', 16); ascstr[16] = '\0';
-   ai = 0;
+/* Print a value as '0x' and the given number of hex digits */
 
-   if (bytesPerUnit > 4) bytesPerUnit = 4;
+static void sinkPutHexValue
+(OSRTPrintSink* pSink, OSUINT32 value, int ndigits, const char* digits)
+{
+   char* p = sinkReserve (pSink, ndigits + 2);
+   int   i;
+
+   if (0 == p) return;
+   p[0] = '0'; p[1] = 'x';
+   for (i = ndigits + 1; i >= 2; i--, value >>= 4) {
+      p[i] = digits[value & 0x0F];
+   }
+   pSink->length += ndigits + 2;
+}
 
-   for (i = 0; i < numocts / bytesPerUnit; i++)
-   {
-      pbuf = (char*)buf;
-      buf [bytesPerUnit * 2] = 0;
-      if (bytesPerUnit == 1) {
-         val = *data++;
-         shift = 0;
+static void sinkPutHexOcts
+(OSRTPrintSink* pSink, const OSOCTET* data, OSSIZE numocts)
+{
+   char*  p;
+   OSSIZE i, n;
+
+   for (; numocts > 0; numocts -= n, data += n) {
+      n = OSRTMIN (numocts, OSRTPRINT_MINBUFSIZE / 2);
+      if (0 == (p = sinkReserve (pSink, n * 2))) return;
+      for (i = 0; i < n; i++) {
+         *p++ = hexDigits[data[i] >> 4];
+         *p++ = hexDigits[data[i] & 0x0F];
       }
-      else if (bytesPerUnit == 2) {
-         val = *data++;
-         val = (val * 256) + *data++;
-         shift = 8;
+      pSink->length += n * 2;
+   }
+}
+
+/* Complete the output of one print call.  The text collected by a     */
+/* memory sink is kept null-terminated; there is always room for the    */
+/* terminator.  Autoflush passes the output on to the stdio buffer of   */
+/* the file, keeping it in order with other output to the file without  */
+/* a system call per value.  JSON output is passed on by whole lines.   */
+
+static void printDone (OSRTPrintSink* pSink)
+{
+   if (0 == pSink->fp) {
+      if (0 != pSink->data) pSink->data[pSink->length] = '\0';
+   }
+   else if ((pSink->flags & OSRTPRINT_AUTOFLUSH) && pSink->length > 0 &&
+            (!IS_JSON (pSink) || pSink->indent == 0)) {
+      sinkWriteFile (pSink, pSink->data, pSink->length);
+      pSink->length = 0;
+      pSink->lineStart = 0;
+   }
+}
+
+/* JSON output.  Values printed outside of braces are wrapped in an     */
+/* object of their own and end a line.                                  */
+
+static void jsonPutEscape (OSRTPrintSink* pSink, OSUINT32 c)
+{
+   char* p = sinkReserve (pSink, 6);
+
+   if (0 == p) return;
+   p[0] = '\\';
+   if (c < 0x80 && jsonEscapes[c] != 'u') {
+      p[1] = jsonEscapes[c];
+      pSink->length += 2;
+   }
+   else {
+      p[1] = 'u';
+      p[2] = hexDigits[(c >> 12) & 0x0F];
+      p[3] = hexDigits[(c >> 8) & 0x0F];
+      p[4] = hexDigits[(c >> 4) & 0x0F];
+      p[5] = hexDigits[c & 0x0F];
+      pSink->length += 6;
+   }
+}
+
+/* Write a UTF-8 string.  A string that is not valid UTF-8 is taken to  */
+/* be Latin-1, so the result is always valid JSON.                      */
+
+static void jsonPutString (OSRTPrintSink* pSink, const char* str, OSSIZE len)
+{
+   const OSOCTET* data = (const OSOCTET*)str;
+   OSBOOL latin1 = (OSBOOL)(rtxValidateUTF8 (data, len) < 0);
+   OSSIZE i = 0, start;
+
+   sinkPutc (pSink, '"');
+
+   while (i < len) {
+      start = i;
+      while (i < len && ((data[i] < 0x80) ?
+                         jsonEscapes[data[i]] == 0 : !latin1)) i++;
+
+      if (i > start) sinkWrite (pSink, str + start, i - start);
+      if (i < len) jsonPutEscape (pSink, data[i++]);
+   }
+
+   sinkPutc (pSink, '"');
+}
+
+/* Write one character of a BMP or universal string as UTF-8 */
+
+static void jsonPutChar (OSRTPrintSink* pSink, OSUINT32 c)
+{
+   char* p;
+
+   if (c < 0x80) {
+      if (jsonEscapes[c] == 0) sinkPutc (pSink, (char)c);
+      else jsonPutEscape (pSink, c);
+   }
+   else if ((c >= 0xD800 && c < 0xE000) || c > 0x10FFFF) {
+      jsonPutEscape (pSink, 0xFFFD);
+   }
+   else if (0 != (p = sinkReserve (pSink, 4))) {
+      if (c < 0x800) {
+         p[0] = (char)(0xC0 | (c >> 6));
+         p[1] = (char)(0x80 | (c & 0x3F));
+         pSink->length += 2;
       }
-      else { /* greater than 2 */
-         OSSIZE ii;
-         for (ii = 0, val = 0; ii < sizeof (OSUINT32); ii++) {
-            val = (val * 256) + *data++;
-         }
-         shift = (sizeof(OSUINT32) - 1) * 8;
+      else if (c < 0x10000) {
+         p[0] = (char)(0xE0 | (c >> 12));
+         p[1] = (char)(0x80 | ((c >> 6) & 0x3F));
+         p[2] = (char)(0x80 | (c & 0x3F));
+         pSink->length += 3;
       }
-      for (k = 0; k < bytesPerUnit; k++, pbuf += 2, shift -= 8) {
-         b = (OSOCTET)((val >> shift) & 0xFF);
-         rtxByteToHexChar (b, pbuf, 20);
-         ascstr[ai++] = (char) (isprint(b) ? b : '.');
+      else {
+         p[0] = (char)(0xF0 | (c >> 18));
+         p[1] = (char)(0x80 | ((c >> 12) & 0x3F));
+         p[2] = (char)(0x80 | ((c >> 6) & 0x3F));
+         p[3] = (char)(0x80 | (c & 0x3F));
+         pSink->length += 4;
       }
-      *pbuf = 0;
-
-      k = i % unitsPerLine * (bytesPerUnit * 2 + 1);
-      memcpy (&hexstr[k], buf, bytesPerUnit * 2);
-
-      if ((dumpstr = (OSOCTET) ((i + 1) % unitsPerLine == 0)) != 0)
-      {
-         fprintf (fp, "%48s %16s\n", hexstr, ascstr);
-         if (i < (numocts - 1)) {
-            OSCRTLMEMSET (hexstr, ' ', 48);
-            OSCRTLMEMSET (ascstr, ' ', 16);
-            ai = 0;
+   }
+}
+
+static void jsonPutHex
+(OSRTPrintSink* pSink, const OSOCTET* data, OSSIZE numocts)
+{
+   sinkPutc (pSink, '"');
+   sinkPutHexOcts (pSink, data, numocts);
+   sinkPutc (pSink, '"');
+}
+
+/* State of the innermost open object, or null if nested too deeply */
+
+static OSRTPrintJSONLevel* jsonLevel (OSRTPrintSink* pSink)
+{
+   OSUINT32 level = pSink->indent / OSRTINDENTSPACES;
+
+   return (level > 0 && level <= OSRTPRINT_JSONDEPTH) ?
+      &pSink->jsonLevels[level - 1] : 0;
+}
+
+/* Start a value, named unless name is null.  A member with the same    */
+/* name as the member before it is added to an array: '"k":v' becomes   */
+/* '"k":[v' and the new value follows a ','.  The array is closed by    */
+/* the next member with another name or the end of the object.  Names   */
+/* are only compared while the earlier one is still in the buffer and   */
+/* needed no escapes.                                                   */
+
+static void jsonBegin (OSRTPrintSink* pSink, const char* name)
+{
+   OSRTPrintJSONLevel* pLevel = jsonLevel (pSink);
+   OSSIZE len = (0 != name) ? strlen (name) : 0, off = 0;
+   OSBOOL track = FALSE;
+
+   if (pSink->indent == 0) {
+      if (0 != name) sinkPutc (pSink, '{');
+   }
+   else {
+      /* The separators, name and ':' must fit without moving the buffer */
+      track = (OSBOOL)(0 != pLevel &&
+                       (pSink->capacity - pSink->length > len + 5 ||
+                        sinkMakeRoom (pSink, len + 5)));
+
+      if (track && 0 != name && pLevel->keyLen == len + 2 &&
+          0 == memcmp (pSink->data + pLevel->keyOff + 1, name, len)) {
+         if (!pLevel->inArray) {
+            off = pLevel->keyOff + pLevel->keyLen + 1;
+            memmove (pSink->data + off + 1, pSink->data + off,
+                     pSink->length - off);
+            pSink->data[off] = '[';
+            pSink->length++;
+            pLevel->inArray = TRUE;
          }
+         sinkPutc (pSink, ',');
+         return;
+      }
+
+      if (0 != pLevel && pLevel->inArray) {
+         sinkPutc (pSink, ']');
+         pLevel->inArray = FALSE;
       }
+      if (pSink->needSep) sinkPutc (pSink, ',');
+   }
+
+   if (0 != name) {
+      off = pSink->length;
+      jsonPutString (pSink, name, len);
+      sinkPutc (pSink, ':');
+   }
+
+   if (0 != pLevel) {
+      pLevel->keyOff = off;
+      pLevel->keyLen = (track && 0 != name &&
+                        pSink->length - off == len + 3) ? len + 2 : 0;
+   }
+}
+
+/* End an open object: close an array of its last member */
+
+static void jsonCloseLevel (OSRTPrintSink* pSink)
+{
+   OSRTPrintJSONLevel* pLevel = jsonLevel (pSink);
+
+   if (0 != pLevel) {
+      if (pLevel->inArray) sinkPutc (pSink, ']');
+      pLevel->keyLen = 0;
+      pLevel->inArray = FALSE;
+   }
+}
+
+static void jsonEnd (OSRTPrintSink* pSink, OSBOOL named)
+{
+   if (pSink->indent == 0) {
+      if (named) sinkWrite (pSink, "}\n", 2);
+      else sinkPutc (pSink, '\n');
+      pSink->needSep = FALSE;
+      pSink->lineStart = pSink->length;
+   }
+   else pSink->needSep = TRUE;
+
+   printDone (pSink);
+}
+
+int rtxPrintSinkInit
+(OSRTPrintSink* pSink, FILE* fp, OSSIZE bufsiz, OSUINT32 flags)
+{
+   if (0 == pSink) return RTERR_NULLPTR;
+
+   memset (pSink, 0, sizeof(OSRTPrintSink));
+
+   if (bufsiz == 0) bufsiz = OSRTPRINT_BUFSIZE;
+   else if (bufsiz < OSRTPRINT_MINBUFSIZE) bufsiz = OSRTPRINT_MINBUFSIZE;
+
+   pSink->data = (char*) malloc (bufsiz);
+   if (0 == pSink->data) return RTERR_NOMEM;
+
+   pSink->data[0] = '\0';
+   pSink->capacity = bufsiz;
+   pSink->fp = fp;
+   pSink->flags = flags;
+
+   return 0;
+}
+
+int rtxPrintSinkFlush (OSRTPrintSink* pSink)
+{
+   if (0 == pSink) return RTERR_NULLPTR;
+
+   if (0 != pSink->fp) {
+      if (pSink->length > 0) {
+         sinkWriteFile (pSink, pSink->data, pSink->length);
+         pSink->length = 0;
+      }
+      if (fflush (pSink->fp) != 0 && pSink->status == 0)
+         pSink->status = RTERR_WRITEERR;
+
+      jsonForgetNames (pSink);
+   }
+   else if (0 != pSink->data) {
+      pSink->data[pSink->length] = '\0';
+   }
+
+   return pSink->status;
+}
+
+void rtxPrintSinkReset (OSRTPrintSink* pSink)
+{
+   if (0 == pSink) return;
+
+   if (0 == pSink->fp) {
+      pSink->length = 0;
+      if (0 != pSink->data) pSink->data[0] = '\0';
+      jsonForgetNames (pSink);
+   }
+   pSink->status = 0;
+}
+
+void rtxPrintSinkFree (OSRTPrintSink* pSink)
+{
+   if (0 == pSink || 0 == pSink->data) return;
+
+   rtxPrintSinkFlush (pSink);
+   free (pSink->data);
+
+   memset (pSink, 0, sizeof(OSRTPrintSink));
+}
+
+OSRTPrintSink* rtxPrintSetSink (OSRTPrintSink* pSink)
+{
+   OSRTPrintSink* pPrevSink = getSink ();
+   g_pSink = pSink;
+   return pPrevSink;
+}
+
+OSRTPrintSink* rtxPrintGetSink (void)
+{
+   return getSink ();
+}
+
+int rtxPrintFlush (void)
+{
+   return rtxPrintSinkFlush (getSink ());
+}
+
+/* Print 'name = ', or the start of a named JSON value */
+
+static OSRTPrintSink* beginValue (const char* name)
+{
+   OSRTPrintSink* pSink = getSink ();
+
+   if (IS_JSON (pSink)) {
+      jsonBegin (pSink, name);
+   }
+   else {
+      sinkPuts (pSink, name);
+      sinkWrite (pSink, " = ", 3);
+   }
+   return pSink;
+}
+
+static void endValue (OSRTPrintSink* pSink)
+{
+   if (IS_JSON (pSink)) {
+      jsonEnd (pSink, TRUE);
+   }
+   else {
+      sinkPutc (pSink, '\n');
+      printDone (pSink);
+   }
+}
+
+/* Print 'name<conn><field> = ' */
+
+static void printField
+(OSRTPrintSink* pSink, const char* name, const char* conn, const char* field)
+{
+   sinkPuts (pSink, name);
+   sinkPuts (pSink, conn);
+   sinkPuts (pSink, field);
+   sinkWrite (pSink, " = ", 3);
+}
+
+void rtxPrintBoolean (const char* name, OSBOOL value)
+{
+   OSRTPrintSink* pSink = beginValue (name);
+   sinkPuts (pSink, value ? "true" : "false");
+   endValue (pSink);
+}
+
+void rtxPrintInteger (const char* name, OSINT32 value)
+{
+   OSRTPrintSink* pSink = beginValue (name);
+   sinkPutInt (pSink, value);
+   endValue (pSink);
+}
+
+void rtxPrintUnsigned (const char* name, OSUINT32 value)
+{
+   OSRTPrintSink* pSink = beginValue (name);
+   sinkPutUInt (pSink, value);
+   endValue (pSink);
+}
+
+/* Big integers are JSON strings, as they may not fit in a double */
+
+void rtxPrintBigInt (const char* name, const ASN1BigInt* pvalue)
+{
+   OSRTPrintSink* pSink = beginValue (name);
+   OSUINT32 i = 0;
+
+   while (i < pvalue->numocts && pvalue->data[i] == 0) i++;
+
+   if (IS_JSON (pSink)) sinkPutc (pSink, '"');
+
+   if (i == pvalue->numocts) {
+      sinkPutc (pSink, '0');
+   }
+   else {
+      sinkPuts (pSink, (pvalue->negative) ? "-0x" : "0x");
+      sinkPutHexOcts (pSink, pvalue->data + i, pvalue->numocts - i);
    }
 
-   if (!dumpstr) fprintf (fp, "%48s %s\n", hexstr, strTrim(ascstr));
+   if (IS_JSON (pSink)) sinkPutc (pSink, '"');
+   endValue (pSink);
+}
+
+void rtxPrintCharStr (const char* name, const char* cstring)
+{
+   OSRTPrintSink* pSink = beginValue (name);
+
+   if (IS_JSON (pSink)) {
+      if (cstring == 0) sinkWrite (pSink, "null", 4);
+      else jsonPutString (pSink, cstring, strlen (cstring));
+   }
+   else {
+      sinkPutc (pSink, '\'');
+      sinkPuts (pSink, (cstring == 0) ? "(null)" : cstring);
+      sinkPutc (pSink, '\'');
+   }
+   endValue (pSink);
 }
 
-static void rtxHexDumpToFile
-(FILE* fp, const OSOCTET* data, OSSIZE numocts)
+void rtxPrintUTF8CharStr (const char* name, const OSUTF8CHAR* cstring)
 {
-   rtxHexDumpToFileEx (fp, data, numocts, 1);
+   rtxPrintCharStr (name, (const char*)cstring);
 }
 
-static void rtxHexDump (const OSOCTET* data, OSSIZE numocts)
+void rtxPrintUnicodeCharStr
+(const char* name, const OSUNICHAR* str, int nchars)
 {
-   rtxHexDumpToFile (stdout, data, numocts);
+   OSRTPrintSink* pSink;
+   int i;
+   if (0 == str) return;
+   if (nchars < 0) {
+      nchars = 0;
+      while (str[nchars] != 0) nchars++;
+   }
+   pSink = beginValue (name);
+   if (IS_JSON (pSink)) {
+      sinkPutc (pSink, '"');
+      for (i = 0; i < nchars; i++) {
+         OSUINT32 c = str[i];
+
+         /* Combine surrogate pairs */
+         if (c >= 0xD800 && c < 0xDC00 && i + 1 < nchars &&
+             str[i + 1] >= 0xDC00 && str[i + 1] < 0xE000) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (str[++i] - 0xDC00);
+         }
+         jsonPutChar (pSink, c);
+      }
+      sinkPutc (pSink, '"');
+   }
+   else {
+      sinkPutc (pSink, '\'');
+      for (i = 0; i < nchars; i++) {
+         if (IS_PRINTABLE (str[i]))
+            sinkPutc (pSink, (char)str[i]);
+         else
+            sinkPutHexValue (pSink, str[i], 4, hexDigits);
+      }
+      sinkPutc (pSink, '\'');
+   }
+   endValue (pSink);
+}
+
+/* Dump units of 1, 2 or 4 octets as lines of hex and ascii text, with  */
+/* 16 octets in each line.                                              */
+
+static void rtxHexDumpEx
+(OSRTPrintSink* pSink, const OSOCTET* data, OSSIZE numocts, int bytesPerUnit)
+{
+   OSSIZE i, numunits;
+   char   line[66], *hexstr = line, *ascstr = line + 49;
+   int    k, n, unitsPerLine, ai = 0;
+
+   if (bytesPerUnit > 4) bytesPerUnit = 4;
+   unitsPerLine = 16 / bytesPerUnit;
+   numunits = numocts / bytesPerUnit;
+
+   memset (line, ' ', sizeof(line) - 1);
+   line[65] = '\n';
+
+   for (i = 0; i < numunits; i++) {
+      k = (int)(i % unitsPerLine) * (bytesPerUnit * 2 + 1);
+
+      for (n = 0; n < bytesPerUnit; n++, data++) {
+         hexstr[k++] = hexDigits[*data >> 4];
+         hexstr[k++] = hexDigits[*data & 0x0F];
+         ascstr[ai++] = (char)(IS_PRINTABLE (*data) ? *data : '.');
+      }
+
+      if ((i + 1) % unitsPerLine == 0) {
+         sinkWrite (pSink, line, sizeof(line));
+         memset (line, ' ', sizeof(line) - 1);
+         ai = 0;
+      }
+   }
+
+   /* A partial last line is written without trailing blanks */
+
+   if (numunits % unitsPerLine != 0) {
+      while (ai > 0 && ascstr[ai - 1] == ' ') ai--;
+      ascstr[ai] = '\n';
+      sinkWrite (pSink, line, 49 + ai + 1);
+   }
 }
 
 void rtxPrintHexStr
 (const char* name, size_t numocts, const OSOCTET* data)
 {
+   OSRTPrintSink* pSink = getSink ();
+
+   if (IS_JSON (pSink)) {
+      jsonBegin (pSink, name);
+      jsonPutHex (pSink, data, numocts);
+      jsonEnd (pSink, TRUE);
+      return;
+   }
+
+   sinkPuts (pSink, name);
    if (numocts <= 32) {
-      OSUINT32 i;
-      printf ("%s = 0x", name);
-      for (i = 0; i < numocts; i++) {
-         printf ("%02x", data[i]);
-      }
-      printf ("\n");
+      sinkWrite (pSink, " = 0x", 5);
+      sinkPutHexOcts (pSink, data, numocts);
+      sinkPutc (pSink, '\n');
    }
    else {
-      printf ("%s =\n", name);
-      rtxHexDump (data, numocts);
+      sinkWrite (pSink, " =\n", 3);
+      rtxHexDumpEx (pSink, data, numocts, 1);
    }
+   printDone (pSink);
 }
 
 void rtxPrintNVP (const char* name, const OSUTF8NVP* pnvp)
 {
-   printf ("%s.name  = '%s'\n", name,
+   OSRTPrintSink* pSink = getSink ();
+
+   if (IS_JSON (pSink)) {
+      jsonBegin (pSink, name);
+      sinkWrite (pSink, "{\"name\":", 8);
+      if (pnvp->name == 0) sinkWrite (pSink, "null", 4);
+      else jsonPutString (pSink, (const char*)pnvp->name,
+                          rtxUTF8LenBytes (pnvp->name));
+      sinkWrite (pSink, ",\"value\":", 9);
+      if (pnvp->value == 0) sinkWrite (pSink, "null", 4);
+      else jsonPutString (pSink, (const char*)pnvp->value,
+                          rtxUTF8LenBytes (pnvp->value));
+      sinkPutc (pSink, '}');
+      jsonEnd (pSink, TRUE);
+      return;
+   }
+
+   sinkPuts (pSink, name);
+   sinkWrite (pSink, ".name  = '", 10);
+   sinkPuts (pSink,
       (pnvp->name == 0) ? "(null)" : (const char*)pnvp->name);
-   printf ("%s.value = '%s'\n", name,
+   sinkWrite (pSink, "'\n", 2);
+   sinkPuts (pSink, name);
+   sinkWrite (pSink, ".value = '", 10);
+   sinkPuts (pSink,
       (pnvp->value == 0) ? "(null)" : (const char*)pnvp->value);
+   sinkWrite (pSink, "'\n", 2);
+   printDone (pSink);
+}
+
+/* Print the numocts and data fields of an octet string and dump it */
+
+static void printOctets (const char* name, const char* conn,
+                         OSSIZE numocts, const OSOCTET* data)
+{
+   OSRTPrintSink* pSink = getSink ();
+
+   if (IS_JSON (pSink)) {
+      jsonBegin (pSink, name);
+      jsonPutHex (pSink, data, numocts);
+      jsonEnd (pSink, TRUE);
+      return;
+   }
+
+   printField (pSink, name, conn, "numocts");
+   sinkPutUInt (pSink, numocts);
+   sinkPutc (pSink, '\n');
+   printField (pSink, name, conn, "data");
+   sinkPutc (pSink, '\n');
+   rtxHexDumpEx (pSink, data, numocts, 1);
+   printDone (pSink);
 }
 
 void rtxPrintHexBinary
 (const char* name, size_t numocts, const OSOCTET* data)
 {
-   printf ("%s.numocts = %zu\n", name, numocts);
-   printf ("%s.data = \n", name);
-   rtxHexDump (data, numocts);
+   printOctets (name, ".", numocts, data);
 }
 
 void rtxPrintNull (const char* name)
 {
-   printf ("%s = <null>\n", name);
+   OSRTPrintSink* pSink = beginValue (name);
+   if (IS_JSON (pSink)) sinkWrite (pSink, "null", 4);
+   else sinkWrite (pSink, "<null>", 6);
+   endValue (pSink);
 }
 
-/* Indentation for brace text printing */
-
-static OSUINT32 g_indent = 0;
+/* Indentation for brace text printing is kept in the sink */
 
 void rtxPrintIndent ()
 {
-   OSUINT32 i;
-   for (i = 0; i < g_indent; i++) printf (" ");
+   OSRTPrintSink* pSink = getSink ();
+   if (IS_JSON (pSink)) return;
+   sinkPutSpaces (pSink, pSink->indent);
+   printDone (pSink);
 }
 
 void rtxPrintIncrIndent ()
 {
-   g_indent += OSRTINDENTSPACES;
+   getSink()->indent += OSRTINDENTSPACES;
 }
 
 void rtxPrintDecrIndent ()
 {
-   if (g_indent > 0)
-      g_indent -= OSRTINDENTSPACES;
+   OSRTPrintSink* pSink = getSink ();
+   if (pSink->indent > 0)
+      pSink->indent -= OSRTINDENTSPACES;
 }
 
 void rtxPrintCloseBrace ()
 {
+   OSRTPrintSink* pSink = getSink ();
+   if (IS_JSON (pSink)) {
+      if (pSink->indent == 0) return;  /* no record is open */
+      jsonCloseLevel (pSink);
+      rtxPrintDecrIndent ();
+      sinkPutc (pSink, '}');
+      jsonEnd (pSink, TRUE);
+      return;
+   }
    rtxPrintDecrIndent ();
-   rtxPrintIndent ();
-   printf ("}\n");
+   sinkPutSpaces (pSink, pSink->indent);
+   sinkWrite (pSink, "}\n", 2);
+   printDone (pSink);
 }
 
 void rtxPrintOpenBrace (const char* name)
 {
-   rtxPrintIndent ();
-   printf ("%s {\n", name);
+   OSRTPrintSink* pSink = getSink ();
+   OSRTPrintJSONLevel* pLevel;
+   if (IS_JSON (pSink)) {
+      jsonBegin (pSink, name);
+      sinkPutc (pSink, '{');
+      rtxPrintIncrIndent ();
+      pLevel = jsonLevel (pSink);
+      if (0 != pLevel) {
+         pLevel->keyLen = 0;
+         pLevel->inArray = FALSE;
+      }
+      pSink->needSep = FALSE;
+      printDone (pSink);
+      return;
+   }
+   sinkPutSpaces (pSink, pSink->indent);
+   sinkPuts (pSink, name);
+   sinkWrite (pSink, " {\n", 3);
    rtxPrintIncrIndent ();
+   printDone (pSink);
 }
 
-static void rtBitStringDump (OSSIZE numbits, const OSOCTET* data)
+static void rtBitStringDump
+(OSRTPrintSink* pSink, OSSIZE numbits, const OSOCTET* data)
 {
    OSSIZE i, numocts = numbits / 8;
    char buff[9];
@@ -245,17 +911,17 @@ static void rtBitStringDump (OSSIZE numbits, const OSOCTET* data)
    if (numbits == 0 || 0 == data) return;
 
    if (numocts > 8)
-      printf ("\n");
+      sinkPutc (pSink, '\n');
 
    for (i = 0; i < numocts; i++) {
       if ((i != 0) && (i % BITSTR_BYTES_IN_LINE == 0)) {
-         printf ("\n");
+         sinkPutc (pSink, '\n');
       }
       else if (i % BITSTR_BYTES_IN_LINE != 0) {
-         printf (" ");
+         sinkPutc (pSink, ' ');
       }
 
-      printf ("0x%02X", data[i]);
+      sinkPutHexValue (pSink, data[i], 2, hexDigitsUC);
    }
 
    if (i * 8 != numbits) {
@@ -264,42 +930,75 @@ static void rtBitStringDump (OSSIZE numbits, const OSOCTET* data)
       OSSIZE j;
 
       for (j = 0; j < nmBits; j++, tm<<=1)
-         buff[j] = ((tm >> 7) & 1) + '0';
+         buff[j] = (char)(((tm >> 7) & 1) + '0');
       for (; j < 8; j++)
          buff[j] = 'x';
 
       if ((i % BITSTR_BYTES_IN_LINE) == (BITSTR_BYTES_IN_LINE - 1))
-         printf ("\n%.8s", buff);
+         sinkPutc (pSink, '\n');
       else if (i > 0)
-         printf (" %.8s", buff);
-      else
-         printf ("%.8s", buff);
+         sinkPutc (pSink, ' ');
+
+      sinkWrite (pSink, buff, 8);
    }
 }
 
+static void jsonPutBitStr
+(const char* name, OSSIZE numbits, const OSOCTET* data)
+{
+   OSRTPrintSink* pSink = getSink ();
+
+   jsonBegin (pSink, name);
+   sinkWrite (pSink, "{\"numbits\":", 11);
+   sinkPutUInt (pSink, numbits);
+   sinkWrite (pSink, ",\"data\":", 8);
+   jsonPutHex (pSink, data, (0 == data) ? 0 : (numbits + 7) / 8);
+   sinkPutc (pSink, '}');
+   jsonEnd (pSink, TRUE);
+}
+
 void rtPrintBitStr (const char* name, OSSIZE numbits,
                     const OSOCTET* data, const char* conn)
 {
-   printf ("%s%snumbits = %zu\n", name, conn, numbits);
-   printf ("%s%sdata = ", name, conn);
-   rtBitStringDump (numbits, data);
-   printf ("\n");
+   OSRTPrintSink* pSink = getSink ();
+
+   if (IS_JSON (pSink)) {
+      jsonPutBitStr (name, numbits, data);
+      return;
+   }
+
+   printField (pSink, name, conn, "numbits");
+   sinkPutUInt (pSink, numbits);
+   sinkPutc (pSink, '\n');
+   printField (pSink, name, conn, "data");
+   rtBitStringDump (pSink, numbits, data);
+   sinkPutc (pSink, '\n');
+   printDone (pSink);
 }
 
 void rtPrintBitStrBraceText
 (const char* name, OSSIZE numbits, const OSOCTET* data)
 {
-   printf ("%s = { %zu, ", name, numbits);
-   rtBitStringDump (numbits, data);
-   printf (" }\n");
+   OSRTPrintSink* pSink;
+
+   if (IS_JSON (getSink ())) {
+      jsonPutBitStr (name, numbits, data);
+      return;
+   }
+
+   pSink = beginValue (name);
+   sinkWrite (pSink, "{ ", 2);
+   sinkPutUInt (pSink, numbits);
+   sinkWrite (pSink, ", ", 2);
+   rtBitStringDump (pSink, numbits, data);
+   sinkWrite (pSink, " }\n", 3);
+   printDone (pSink);
 }
 
 void rtPrintOctStr (const char* name, OSSIZE numocts,
                     const OSOCTET* data, const char* conn)
 {
-   printf ("%s%snumocts = %zu\n", name, conn, numocts);
-   printf ("%s%sdata = \n", name, conn);
-   rtxHexDump (data, numocts);
+   printOctets (name, conn, numocts, data);
 }
 
 void rtPrint16BitCharStr
@@ -311,10 +1010,21 @@ void rtPrint16BitCharStr
 void rtPrint32BitCharStr
 (const char* name, const Asn132BitCharString* bstring, const char* conn)
 {
-   printf ("%s%snchars = %u\n", name, conn, bstring->nchars);
-   printf ("%s%sdata = \n", name, conn);
-   rtxHexDumpToFileEx (stdout, (OSOCTET*)bstring->data,
-                       bstring->nchars * sizeof (OSUINT32), 4);
+   OSRTPrintSink* pSink = getSink ();
+
+   if (IS_JSON (pSink)) {
+      rtPrintUnivCharStr (name, bstring);
+      return;
+   }
+
+   printField (pSink, name, conn, "nchars");
+   sinkPutUInt (pSink, bstring->nchars);
+   sinkPutc (pSink, '\n');
+   printField (pSink, name, conn, "data");
+   sinkPutc (pSink, '\n');
+   rtxHexDumpEx (pSink, (const OSOCTET*)bstring->data,
+                 bstring->nchars * sizeof (OSUINT32), 4);
+   printDone (pSink);
 }
 
 void rtPrintOID (const char* name, const ASN1OBJID* pOID)
@@ -327,34 +1037,87 @@ void rtPrintOIDValue (const ASN1OBJID* pOID)
    rtPrintOIDValue2(pOID->numids, pOID->subid);
 }
 
+/* An OID is printed as '{ 1 2 3 }', or as the JSON string "1.2.3" */
+
+static void printOIDValue
+(OSRTPrintSink* pSink, OSSIZE numids, const OSUINT32* subidArray)
+{
+   OSSIZE ui;
+
+   if (IS_JSON (pSink)) {
+      sinkPutc (pSink, '"');
+      for (ui = 0; ui < numids; ui++) {
+         if (ui > 0) sinkPutc (pSink, '.');
+         sinkPutUInt (pSink, subidArray[ui]);
+      }
+      sinkPutc (pSink, '"');
+      return;
+   }
+
+   sinkWrite (pSink, "{ ", 2);
+   for (ui = 0; ui < numids; ui++) {
+      sinkPutUInt (pSink, subidArray[ui]);
+      sinkPutc (pSink, ' ');
+   }
+   sinkWrite (pSink, "}\n", 2);
+}
+
 void rtPrintOID2
 (const char* name, OSSIZE numids, const OSUINT32* subidArray)
 {
-   printf ("%s = ", name);
-   rtPrintOIDValue2 (numids, subidArray);
+   OSRTPrintSink* pSink = beginValue (name);
+   printOIDValue (pSink, numids, subidArray);
+   if (IS_JSON (pSink)) jsonEnd (pSink, TRUE);
+   else printDone (pSink);
 }
 
 void rtPrintOIDValue2 (OSSIZE numids, const OSUINT32* subidArray)
 {
-   OSSIZE ui;
-   printf ("{ ");
-   for (ui = 0; ui < numids; ui++) {
-      printf ("%d ", subidArray[ui]);
-   }
-   printf ("}\n");
+   OSRTPrintSink* pSink = getSink ();
+   if (IS_JSON (pSink)) jsonBegin (pSink, 0);
+   printOIDValue (pSink, numids, subidArray);
+   if (IS_JSON (pSink)) jsonEnd (pSink, FALSE);
+   else printDone (pSink);
 }
 
 void rtPrintOpenType (const char* name, OSSIZE numocts,
                       const OSOCTET* data, const char*  conn)
 {
-   printf ("%s%snumocts = %zu\n", name, conn, numocts);
-   printf ("%s%sdata = \n", name, conn);
-   rtxHexDump (data, numocts);
+   printOctets (name, conn, numocts, data);
+}
+
+/* Open type extensions are printed as a JSON array of hex strings */
+
+static void jsonPutOpenTypeExt (const char* name, const OSRTDList* pElemList)
+{
+   OSRTPrintSink* pSink = getSink ();
+   OSRTDListNode* pnode;
+   ASN1OpenType*  pOpenType;
+   OSBOOL first = TRUE;
+
+   if (0 == pElemList) return;
+
+   jsonBegin (pSink, name);
+   sinkPutc (pSink, '[');
+   for (pnode = pElemList->head; 0 != pnode; pnode = pnode->next) {
+      if (0 != pnode->data) {
+         pOpenType = (ASN1OpenType*) pnode->data;
+         if (!first) sinkPutc (pSink, ',');
+         jsonPutHex (pSink, pOpenType->data, pOpenType->numocts);
+         first = FALSE;
+      }
+   }
+   sinkPutc (pSink, ']');
+   jsonEnd (pSink, TRUE);
 }
 
 void rtPrintOpenTypeExt (const char* name, const OSRTDList* pElemList)
 {
    ASN1OpenType* pOpenType;
+   if (IS_JSON (getSink ())) {
+      jsonPutOpenTypeExt (name, pElemList);
+      return;
+   }
    if (0 != pElemList) {
       OSRTDListNode* pnode = pElemList->head;
       while (0 != pnode) {
@@ -369,21 +1132,36 @@ void rtPrintOpenTypeExt (const char* name, const OSRTDList* pElemList)
 
 void rtPrintUnivCharStr (const char* name, const Asn132BitCharString* bstring)
 {
+   OSRTPrintSink* pSink = beginValue (name);
    OSUINT32 i;
-   printf ("%s = '", name);
-   for (i = 0; i < bstring->nchars; i++) {
-      if (isprint (bstring->data[i]))
-         putc (bstring->data[i], stdout);
-      else
-         printf ("0x%08x", bstring->data[i]);
+   if (IS_JSON (pSink)) {
+      sinkPutc (pSink, '"');
+      for (i = 0; i < bstring->nchars; i++) {
+         jsonPutChar (pSink, bstring->data[i]);
+      }
+      sinkPutc (pSink, '"');
    }
-   printf ("'\n");
+   else {
+      sinkPutc (pSink, '\'');
+      for (i = 0; i < bstring->nchars; i++) {
+         if (IS_PRINTABLE (bstring->data[i]))
+            sinkPutc (pSink, (char)bstring->data[i]);
+         else
+            sinkPutHexValue (pSink, bstring->data[i], 8, hexDigits);
+      }
+      sinkPutc (pSink, '\'');
+   }
+   endValue (pSink);
 }
 
 void rtPrintOpenTypeExtBraceText
 (const char* name, const OSRTDList* pElemList)
 {
    ASN1OpenType* pOpenType;
+   if (IS_JSON (getSink ())) {
+      jsonPutOpenTypeExt (name, pElemList);
+      return;
+   }
    if (0 != pElemList) {
       OSRTDListNode* pnode = pElemList->head;
       while (0 != pnode) {
@@ -396,4 +1174,3 @@ void rtPrintOpenTypeExtBraceText
       }
    }
 }
-
@@ -107,6 +107,19 @@ rtxErrSetData(pctxt,stat,__FILE__,__LINE__)
 #define EXTERN EXTERNRT
 #endif
 
+/* This attribute marks functions that are only called on error paths. */
+/* The compiler treats branches leading to calls to them as unlikely    */
+/* and moves that code out of the main body of the calling function.    */
+
+#ifndef OSRT_COLD
+#if defined(__GNUC__) && ((__GNUC__ > 4) || \
+   ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 3)))
+#define OSRT_COLD __attribute__((cold))
+#else
+#define OSRT_COLD
+#endif
+#endif
+
 #define OSCRTLMEMSET    memset
 #define OSCRTLMEMCMP    memcmp
 #define OSCRTLMEMCPY    memcpy
@@ -189,12 +202,25 @@ typedef struct {
    int          lineno;
 } ASN1ErrLocn;
 
+/* Function used to format a deferred error parameter.  It is only     */
+/* called when the error text is requested.                             */
+
+typedef const char* (*ASN1ErrParmFmtFunc)
+   (OSUINT32 value, char* buffer, size_t bufsiz);
+
 typedef struct {
-   ASN1ErrLocn  stack[ASN_K_MAXERRSTK];
+   ASN1ErrParmFmtFunc fmtFunc;  /* function to format value             */
+   OSUINT32     value;          /* parameter value                      */
+} ASN1ErrLazyParm;
+
+typedef struct {
+   ASN1ErrLocn  stack[ASN_K_MAXERRSTK];  /* only with OSRT_ERRSTACK     */
    int          stkx;
    int          status;
+   ASN1ErrLocn  first;          /* where status was first set           */
    int          parmcnt;
-   const char*  parms[ASN_K_MAXERRP];
+   const char*  parms[ASN_K_MAXERRP];      /* null for deferred parms  */
+   ASN1ErrLazyParm lazyParms[ASN_K_MAXERRP];
 } ASN1ErrInfo;
 
 /* Flag mask constant values */
@@ -208,6 +234,7 @@ typedef struct {
 #define ASN1CANXER      0x0200  /* canonical XER                        */
 #define ASN1SAVEBUF     0x0100  /* do not free dynamic encode buffer    */
 #define ASN1OPENTYPE    0x0080  /* item is an open type field           */
+#define ASN1STRICTSTR   0x0040  /* check character string contents      */
 
 /* ASN.1 encode/decode context block structure */
 
@@ -314,6 +341,29 @@ EXTERNRT OSRTDListNode* rtxDListAppend
 EXTERNRT OSRTDListNode* rtxDListAppendNode
 (OSRTDList* pList, OSRTDListNode* pListNode);
 
+/**
+ * This function allocates a given number of list nodes, each with an
+ * attached zero-initialized data item of the given size, and appends them
+ * to the linked list structure. It is a bulk form of the
+ * rtxDListAllocNodeAndData macro: all nodes and data items are carved out
+ * of a single rtxMemAlloc block, so only one allocation is done regardless
+ * of the count.
+ *
+ * Because the nodes share a single memory block, freeing an individual
+ * node or data item with rtxMemFreePtr has no effect. The memory is
+ * released when memFree is called or the context is released.
+ *
+ * @param pctxt       A pointer to a context structure.
+ * @param pList        A pointer to a linked list structure onto which the
+ *                       nodes are to be appended.
+ * @param count        Number of nodes to allocate.
+ * @param elemSize     Size in bytes of the data item attached to each node.
+ * @return             A pointer to the first of the appended nodes or NULL
+ *                       if count is zero or memory allocation failed.
+ */
+EXTERNRT OSRTDListNode* rtxDListAllocNodesAndData
+(OSCTXT* pctxt, OSRTDList* pList, size_t count, size_t elemSize);
+
 /**
  * This function initializes a doubly linked list structure. It sets the number
  * of elements to zero and sets al internal pointer values to NULL. A doubly
@@ -411,7 +461,7 @@ EXTERNRT OSRTSListNode* rtxSListAppend (OSRTSList* pList, void* pData);
  * @param errParm      The typed error parameter.
  * @return             The status of the operation.
  */
-EXTERNRT int rtxErrAddIntParm (OSCTXT* pctxt, int errParm);
+EXTERNRT OSRT_COLD int rtxErrAddIntParm (OSCTXT* pctxt, int errParm);
 
 /**
  * This function adds a 64-bit integer parameter to an error information
@@ -426,7 +476,7 @@ EXTERNRT int rtxErrAddIntParm (OSCTXT* pctxt, int errParm);
  * @return             The status of the operation (TRUE if the parameter was
  *                       sucessfully added).
  */
-EXTERNRT OSBOOL rtxErrAddInt64Parm (OSCTXT* pctxt, OSINT64 errParm);
+EXTERNRT OSRT_COLD OSBOOL rtxErrAddInt64Parm (OSCTXT* pctxt, OSINT64 errParm);
 
 /**
  * This function adds an unsigned integer parameter to an error information
@@ -442,7 +492,7 @@ EXTERNRT OSBOOL rtxErrAddInt64Parm (OSCTXT* pctxt, OSINT64 errParm);
  * @param errParm      The typed error parameter.
  * @return             The status of the operation.
  */
-EXTERNRT int rtxErrAddUIntParm (OSCTXT* pctxt, unsigned int errParm);
+EXTERNRT OSRT_COLD int rtxErrAddUIntParm (OSCTXT* pctxt, unsigned int errParm);
 
 /**
  * This function adds an unsigned 64-bit integer parameter to an error
@@ -453,7 +503,7 @@ EXTERNRT int rtxErrAddUIntParm (OSCTXT* pctxt, unsigned int errParm);
  * @return             The status of the operation (TRUE if the parameter was
  *                       sucessfully added).
  */
-EXTERNRT OSBOOL rtxErrAddUInt64Parm (OSCTXT* pctxt, OSUINT64 errParm);
+EXTERNRT OSRT_COLD OSBOOL rtxErrAddUInt64Parm (OSCTXT* pctxt, OSUINT64 errParm);
 
 /**
  * Add an element name parameter to the context error information structure
@@ -465,7 +515,7 @@ EXTERNRT OSBOOL rtxErrAddUInt64Parm (OSCTXT* pctxt, OSUINT64 errParm);
  *                       calls.
  * @return            True if element name was added.
  */
-EXTERNRT OSBOOL rtxErrAddElemNameParm (OSCTXT* pctxt);
+EXTERNRT OSRT_COLD OSBOOL rtxErrAddElemNameParm (OSCTXT* pctxt);
 
 /**
  * This function adds an string parameter to an error information structure.
@@ -481,7 +531,23 @@ EXTERNRT OSBOOL rtxErrAddElemNameParm (OSCTXT* pctxt);
  * @param errprm_p     The typed error parameter.
  * @return             The status of the operation.
  */
-EXTERNRT int rtxErrAddStrParm (OSCTXT* pctxt, const char* errprm_p);
+EXTERNRT OSRT_COLD int rtxErrAddStrParm (OSCTXT* pctxt, const char* errprm_p);
+
+/**
+ * This function adds a deferred parameter to an error information
+ * structure. Only the value and the function used to format it are stored;
+ * the text is not produced until the error text is requested using
+ * rtxErrGetText or rtxErrPrint. This makes it cheap to set parameters for
+ * errors that are likely to be discarded.
+ *
+ * @param pctxt        A pointer to a context structure.
+ * @param fmtFunc      Function used to format the value.
+ * @param value        The error parameter value.
+ * @return             The status of the operation (TRUE if the parameter was
+ *                       sucessfully added).
+ */
+EXTERNRT int rtxErrAddLazyParm
+(OSCTXT* pctxt, ASN1ErrParmFmtFunc fmtFunc, OSUINT32 value);
 
 /**
  * This function checks the context structure for non-fatal errors.  If any
@@ -515,7 +581,7 @@ EXTERNRT void rtxErrFreeParms (OSCTXT* pctxt);
  *
  * @param pctxt       A pointer to a context structure.
  */
-EXTERNRT char* rtxErrGetText (OSCTXT* pctxt);
+EXTERNRT OSRT_COLD char* rtxErrGetText (OSCTXT* pctxt);
 
 /**
  * This function prints error information to the standard output device. The
@@ -529,7 +595,7 @@ EXTERNRT char* rtxErrGetText (OSCTXT* pctxt);
  *                       variables that must be maintained between function
  *                       calls.
  */
-EXTERNRT void rtxErrPrint (OSCTXT* pctxt);
+EXTERNRT OSRT_COLD void rtxErrPrint (OSCTXT* pctxt);
 
 /**
  * This function resets the error information in the error information
@@ -544,10 +610,12 @@ EXTERNRT int rtxErrReset (OSCTXT* pctxt);
 
 /**
  * This function sets error information in an error information structure. The
- * information set includes status code, module name, and line number. Location
- * information (i.e. module name and line number) is pushed onto a stack within
- * the error information structure to provide a complete stack trace when the
- * information is printed out.
+ * information set includes status code, module name, and line number. The
+ * first status logged is kept together with the location (i.e. module name
+ * and line number) at which it was logged. If the run-time library was built
+ * with OSRT_ERRSTACK defined, the location of every call is also pushed onto
+ * a stack within the error information structure to provide a complete stack
+ * trace when the information is printed out.
  *
  * @param pctxt        A pointer to a context structure. This provides a
  *                       storage area for the function to store all working
@@ -565,8 +633,8 @@ EXTERNRT int rtxErrReset (OSCTXT* pctxt);
  *                       information and return the status value in one line of
  *                       code.
  */
-EXTERNRT int rtxErrSetData (OSCTXT* pctxt, int status,
-                            const char* module, int lno);
+EXTERNRT OSRT_COLD int rtxErrSetData (OSCTXT* pctxt, int status,
+                                      const char* module, int lno);
 
 /**
  * @}
@@ -731,6 +799,21 @@ EXTERNRT void rtxMemReset (OSCTXT* pctxt);
  */
 EXTERNRT OSBOOL rtxMemHeapIsEmpty (OSCTXT* pctxt);
 
+/**
+ * Move all memory held within one context to another. After the call, the
+ * blocks allocated using the source context are owned by the destination
+ * context and are released when memFree is called on the destination
+ * context; the source context heap is left empty. This is used to hand
+ * over the results of decoding done on a separate context, for example in
+ * another thread.
+ *
+ * @param pDestCtxt    - Pointer to the context to receive the memory.
+ * @param pSrcCtxt     - Pointer to the context whose memory is moved.
+ * @return             - 0 on success or RTERR_NOMEM if the destination
+ *   heap could not be created.
+ */
+EXTERNRT int rtxMemHeapTransfer (OSCTXT* pDestCtxt, OSCTXT* pSrcCtxt);
+
 EXTERNRT void rtxMemFreeOpenSeqExt (OSCTXT* pctxt, OSRTDList* pElemList);
 
 /**
@@ -818,17 +901,175 @@ EXTERNRT void rtxCopyContext (OSCTXT* pdest, OSCTXT* psrc);
  */
 /* UTF-8 string functions */
 
+/**
+ * This function checks that a buffer holds well-formed UTF-8 as defined
+ * in RFC 3629: overlong forms, surrogates and values above U+10FFFF are
+ * rejected.
+ *
+ * @param inbuf        Characters to be checked.
+ * @param nbytes       Number of bytes.
+ * @return             Number of characters, or RTERR_INVUTF8 if the
+ *                       buffer is not valid UTF-8.
+ */
+EXTERNRT int rtxValidateUTF8 (const OSUTF8CHAR* inbuf, size_t nbytes);
+
+/**
+ * This function returns the number of characters in a null-terminated
+ * UTF-8 string, or RTERR_INVUTF8 if it is not valid UTF-8.
+ */
 EXTERNRT int rtxUTF8Len (const OSUTF8CHAR* inbuf);
 EXTERNRT size_t rtxUTF8LenBytes (const OSUTF8CHAR* inbuf);
 
+/**
+ * This function converts big-endian 16-bit characters, as they appear in
+ * the contents of an encoded BMPString, to an array of characters. The
+ * source and destination may be the same buffer.
+ *
+ * @param src          Encoded characters, two octets each.
+ * @param nchars       Number of characters.
+ * @param dest         Array to receive the characters.
+ */
+EXTERNRT void rtxBMPCharsFromBE
+(const OSOCTET* src, OSSIZE nchars, OSUNICHAR* dest);
+
+/**
+ * This function converts an array of 16-bit characters to big-endian
+ * octets. The source and destination may be the same buffer.
+ *
+ * @param src          Characters to be converted.
+ * @param nchars       Number of characters.
+ * @param dest         Buffer of 2 * nchars octets to receive the result.
+ */
+EXTERNRT void rtxBMPCharsToBE
+(const OSUNICHAR* src, OSSIZE nchars, OSOCTET* dest);
+
+/**
+ * This function converts big-endian 32-bit characters, as they appear in
+ * the contents of an encoded UniversalString, to an array of characters.
+ * The source and destination may be the same buffer.
+ *
+ * @param src          Encoded characters, four octets each.
+ * @param nchars       Number of characters.
+ * @param dest         Array to receive the characters.
+ */
+EXTERNRT void rtxUCS4CharsFromBE
+(const OSOCTET* src, OSSIZE nchars, OS32BITCHAR* dest);
+
+/**
+ * This function converts an array of 32-bit characters to big-endian
+ * octets. The source and destination may be the same buffer.
+ *
+ * @param src          Characters to be converted.
+ * @param nchars       Number of characters.
+ * @param dest         Buffer of 4 * nchars octets to receive the result.
+ */
+EXTERNRT void rtxUCS4CharsToBE
+(const OS32BITCHAR* src, OSSIZE nchars, OSOCTET* dest);
+
+/**
+ * This function transcodes big-endian 16-bit characters, as they appear
+ * in the contents of an encoded BMPString, to a null-terminated UTF-8
+ * string. Surrogate code points are rejected.
+ *
+ * @param src          Encoded characters, two octets each.
+ * @param nbytes       Number of octets; must be even.
+ * @param dest         Buffer to receive the string, or NULL to only
+ *                       compute its length.
+ * @param bufsiz       Size of the buffer, including the terminator.
+ * @return             Length of the UTF-8 string in bytes, not including
+ *                       the terminator, or a negative status value if an
+ *                       error occurred.
+ */
+EXTERNRT int rtxBMPToUTF8
+(const OSOCTET* src, size_t nbytes, OSUTF8CHAR* dest, size_t bufsiz);
+
+/**
+ * This function transcodes big-endian 32-bit characters, as they appear
+ * in the contents of an encoded UniversalString, to a null-terminated
+ * UTF-8 string. Surrogate code points and values above U+10FFFF are
+ * rejected.
+ *
+ * @param src          Encoded characters, four octets each.
+ * @param nbytes       Number of octets; must be a multiple of four.
+ * @param dest         Buffer to receive the string, or NULL to only
+ *                       compute its length.
+ * @param bufsiz       Size of the buffer, including the terminator.
+ * @return             Length of the UTF-8 string in bytes, not including
+ *                       the terminator, or a negative status value if an
+ *                       error occurred.
+ */
+EXTERNRT int rtxUCS4ToUTF8
+(const OSOCTET* src, size_t nbytes, OSUTF8CHAR* dest, size_t bufsiz);
+
+/**
+ * This function transcodes UTF-8 characters to big-endian 16-bit
+ * characters, as used in the contents of an encoded BMPString.
+ * Characters outside the Basic Multilingual Plane are rejected.
+ *
+ * @param src          UTF-8 characters to be converted.
+ * @param nbytes       Number of bytes.
+ * @param dest         Buffer to receive the octets, or NULL to only
+ *                       compute their number.
+ * @param bufsiz       Size of the buffer.
+ * @return             Number of octets, or a negative status value if an
+ *                       error occurred.
+ */
+EXTERNRT int rtxUTF8ToBMP
+(const OSUTF8CHAR* src, size_t nbytes, OSOCTET* dest, size_t bufsiz);
+
+/**
+ * This function transcodes UTF-8 characters to big-endian 32-bit
+ * characters, as used in the contents of an encoded UniversalString.
+ *
+ * @param src          UTF-8 characters to be converted.
+ * @param nbytes       Number of bytes.
+ * @param dest         Buffer to receive the octets, or NULL to only
+ *                       compute their number.
+ * @param bufsiz       Size of the buffer.
+ * @return             Number of octets, or a negative status value if an
+ *                       error occurred.
+ */
+EXTERNRT int rtxUTF8ToUCS4
+(const OSUTF8CHAR* src, size_t nbytes, OSOCTET* dest, size_t bufsiz);
+
 EXTERNRT const char* rtBMPToCString
 (ASN1BMPString* pBMPString, char* cstring, OSSIZE cstrsize);
 
 EXTERNRT const char* rtUCSToCString
 (ASN1UniversalString* pUCSString, char* cstring, OSSIZE cstrsize);
 
+/**
+ * This function checks that a null-terminated string only contains
+ * characters permitted by the string type with the given universal tag:
+ * UTF8String, NumericString, PrintableString, IA5String or VisibleString.
+ * Strings with any other tag are not checked.
+ *
+ * @param tag          Tag of the string type.
+ * @param pdata        String to be checked.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - RTERR_INVCHAR or RTERR_INVUTF8 if the string
+ *                         contains a character not in its type.
+ */
 EXTERNRT int rtValidateStr (OSUINT32 tag, const char *pdata);
 
+/**
+ * This function checks the characters of a string as described for
+ * rtValidateStr and copies them in the same pass. The destination is not
+ * null-terminated.
+ *
+ * @param tag          Tag of the string type.
+ * @param dest         Buffer of at least nbytes to receive the copy, or
+ *                       NULL to only check the string.
+ * @param src          Characters to be checked.
+ * @param nbytes       Number of bytes.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtValidateStrCopy
+(OSUINT32 tag, char* dest, const char* src, size_t nbytes);
+
 /**
  * This function compares two OID values for equality.
  *
@@ -847,6 +1088,19 @@ EXTERNRT OSBOOL rtOIDsEqual (const ASN1OBJID* pOID1, const ASN1OBJID* pOID2);
  */
 EXTERNRT OSBOOL rtCopyOID (const ASN1OBJID* srcOID, ASN1OBJID* dstOID);
 
+/**
+ * This function compares two OID values in encoded form for equality. If
+ * both values have an interned handle, only the handles are compared;
+ * otherwise, the contents octets are compared. Handles are only
+ * comparable if both values were interned in the same table.
+ *
+ * @param pOID1         Pointer to first OID value to compare.
+ * @param pOID2         Pointer to second OID value to compare.
+ * @return              True if OID's are equal.
+ */
+EXTERNRT OSBOOL rtEncOIDsEqual
+(const ASN1EncOID* pOID1, const ASN1EncOID* pOID2);
+
 /**
  * Encode binary data into base64 string form to a dynamic buffer.
  *
@@ -878,6 +1132,141 @@ EXTERNRT long rtxBase64EncodeData (OSCTXT* pctxt, const char* pSrcData,
 EXTERNRT long rtxBase64DecodeData
 (OSCTXT* pctxt, const char* pSrcData, size_t srcDataSize, OSOCTET** ppDstData);
 
+/**
+ * State of a base64 conversion of data given in chunks. Initialize it with
+ * rtxBase64Init before the first chunk.
+ */
+typedef struct OSBase64State {
+   OSUINT32     bits;           /* octets or 6-bit values held over     */
+   OSUINT32     count;          /* number of octets or values held      */
+   OSBOOL       padded;         /* last group ended with padding        */
+} OSBase64State;
+
+/**
+ * This function initializes the state of a chunked base64 conversion.
+ *
+ * @param pState       Pointer to state structure.
+ */
+EXTERNRT void rtxBase64Init (OSBase64State* pState);
+
+/**
+ * Encode binary data into base64 string form in a caller-supplied buffer.
+ *
+ * @param src          Pointer to binary data to encode.
+ * @param nbytes       Length of the binary data in octets.
+ * @param dest         Buffer to receive the null-terminated string.
+ * @param bufsiz       Size of the buffer; must be at least
+ *                       4 * ((nbytes + 2) / 3) + 1.
+ * @return             Number of characters written, not including the
+ *                       terminator, or a negative status value.
+ */
+EXTERNRT long rtxBase64Encode
+(const OSOCTET* src, size_t nbytes, char* dest, size_t bufsiz);
+
+/**
+ * Encode one chunk of binary data into base64 form. Complete groups of
+ * three octets are encoded; up to two remaining octets are held in the
+ * state for the next chunk or for rtxBase64EncodeFinish. The output is not
+ * null-terminated.
+ *
+ * @param pState       Pointer to state structure.
+ * @param src          Pointer to binary data to encode.
+ * @param nbytes       Length of the binary data in octets.
+ * @param dest         Buffer to receive the characters.
+ * @param bufsiz       Size of the buffer; 4 * ((nbytes + 2) / 3) is
+ *                       always enough.
+ * @return             Number of characters written, or a negative status
+ *                       value.
+ */
+EXTERNRT long rtxBase64EncodeChunk
+(OSBase64State* pState, const OSOCTET* src, size_t nbytes,
+ char* dest, size_t bufsiz);
+
+/**
+ * Finish a chunked base64 encoding by writing any octets held in the
+ * state as a final padded group.
+ *
+ * @param pState       Pointer to state structure.
+ * @param dest         Buffer to receive the characters.
+ * @param bufsiz       Size of the buffer; 4 is always enough.
+ * @return             Number of characters written, or a negative status
+ *                       value.
+ */
+EXTERNRT long rtxBase64EncodeFinish
+(OSBase64State* pState, char* dest, size_t bufsiz);
+
+/**
+ * Decode a base64 string to binary form in a caller-supplied buffer. White
+ * space is ignored. The final group may be unpadded.
+ *
+ * @param src          Pointer to base64 string to decode.
+ * @param nchars       Length of the base64 string.
+ * @param dest         Buffer to receive the binary data.
+ * @param bufsiz       Size of the buffer; 3 * (nchars / 4) + 2 is always
+ *                       enough.
+ * @return             Number of octets written, or a negative status value.
+ */
+EXTERNRT long rtxBase64Decode
+(const char* src, size_t nchars, OSOCTET* dest, size_t bufsiz);
+
+/**
+ * Decode one chunk of a base64 string. Chunks may split groups of
+ * characters at any point; the characters of an incomplete group are held
+ * in the state for the next chunk or for rtxBase64DecodeFinish.
+ *
+ * @param pState       Pointer to state structure.
+ * @param src          Pointer to base64 characters to decode.
+ * @param nchars       Number of characters.
+ * @param dest         Buffer to receive the binary data.
+ * @param bufsiz       Size of the buffer; 3 * ((nchars + 3) / 4) is
+ *                       always enough.
+ * @return             Number of octets written, or a negative status value.
+ */
+EXTERNRT long rtxBase64DecodeChunk
+(OSBase64State* pState, const char* src, size_t nchars,
+ OSOCTET* dest, size_t bufsiz);
+
+/**
+ * Finish a chunked base64 decoding. An unpadded final group of two or
+ * three characters is decoded; a single remaining character is an error.
+ *
+ * @param pState       Pointer to state structure.
+ * @param dest         Buffer to receive the binary data.
+ * @param bufsiz       Size of the buffer; 2 is always enough.
+ * @return             Number of octets written, or a negative status value.
+ */
+EXTERNRT long rtxBase64DecodeFinish
+(OSBase64State* pState, OSOCTET* dest, size_t bufsiz);
+
+/**
+ * Decode the next PEM block (RFC 7468) of a text such as a certificate
+ * bundle. Text outside "-----BEGIN label-----" and "-----END label-----"
+ * lines is skipped. The contents are decoded into the given buffer, ready
+ * to be decoded with xd_setp.
+ *
+ * @param data         PEM text.
+ * @param size         Length of the text.
+ * @param pOffset      Offset in the text at which to search for the next
+ *                       block. It is advanced past the block found. If the
+ *                       block is not valid, it is advanced past the END
+ *                       line of the block or, if there is none, its BEGIN
+ *                       line, so that decoding can go on with the next
+ *                       block.
+ * @param dest         Buffer to receive the contents of the block. A buffer
+ *                       the size of the text is always enough.
+ * @param bufsiz       Size of the buffer.
+ * @param ppLabel      Pointer to receive the address of the label within
+ *                       the text, such as "CERTIFICATE". May be NULL.
+ * @param pLabelLen    Pointer to receive the length of the label. May be
+ *                       NULL.
+ * @return             Number of octets written, RTERR_ENDOFBUF if there
+ *                       are no more blocks, or another negative status
+ *                       value if the block is invalid.
+ */
+EXTERNRT long rtxPEMDecodeNext
+(const char* data, size_t size, size_t* pOffset, OSOCTET* dest,
+ size_t bufsiz, const char** ppLabel, size_t* pLabelLen);
+
 /**
  * @defgroup ccfDateTime Date/time conversion functions
  * @{
@@ -927,6 +1316,28 @@ EXTERNRT int rtxCmpTime
 EXTERNRT int rtxCmpDateTime
    (const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2);
 
+/**
+ * This function returns the difference in seconds between two
+ * OSNumDateTime values, taking time zones into account. Fractions of a
+ * second are discarded.
+ *
+ * @param pvalue1     Pointer to OSNumDateTime structure.
+ * @param pvalue2     Pointer to OSNumDateTime structure.
+ * @return            Number of seconds from the second value to the first;
+ *                      negative if the first value is earlier.
+ */
+EXTERNRT OSINT64 rtxDateTimeDiff
+   (const OSNumDateTime* pvalue1, const OSNumDateTime* pvalue2);
+
+/**
+ * This function converts an OSNumDateTime value with a time zone to UTC
+ * by applying the time zone offset, which is then set to zero. A value
+ * without a time zone is not changed.
+ *
+ * @param pvalue      Pointer to OSNumDateTime structure to normalize.
+ */
+EXTERNRT void rtxDateTimeNormalize (OSNumDateTime* pvalue);
+
 /**
  * This function verifies that date members (year, month, day, timezone)
  * of the OSNumDateTime structure contains valid values.
@@ -960,6 +1371,154 @@ EXTERNRT int rtParseGeneralizedTime
 EXTERNRT int rtParseUTCTime
 (OSCTXT *pctxt, const char* value, OSNumDateTime* dateTime);
 
+/**
+ * This function converts a date/time value to the number of seconds since
+ * 1970-01-01 00:00:00 UTC. If no time zone is set, the value is taken to
+ * be in UTC. Any fraction of a second is discarded.
+ *
+ * @param dateTime    Pointer to OSNumDateTime structure to be converted.
+ * @param pSecs       Pointer to variable to receive the number of seconds.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - negative return value is error.
+ */
+EXTERNRT int rtxDateTimeToEpoch
+(const OSNumDateTime* dateTime, OSINT64* pSecs);
+
+/**
+ * This function converts an array of date/time values to seconds since
+ * 1970-01-01 00:00:00 UTC as described for rtxDateTimeToEpoch. All values
+ * are converted even if some are invalid, so that the loop has no early
+ * exit.
+ *
+ * @param values      Array of OSNumDateTime structures.
+ * @param count       Number of values.
+ * @param pSecs       Array to receive the number of seconds for each.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - RTERR_BADVALUE if any value is invalid,
+ *                      - other negative return value is error.
+ */
+EXTERNRT int rtxDateTimeToEpochArray
+(const OSNumDateTime* values, OSSIZE count, OSINT64* pSecs);
+
+/**
+ * This function converts a number of seconds and nanoseconds since
+ * 1970-01-01 00:00:00 UTC to a date/time value with a UTC time zone.
+ *
+ * @param secs        Number of seconds since the epoch.
+ * @param nsecs       Nanoseconds (0 to 999999999).
+ * @param dateTime    Pointer to OSNumDateTime structure to receive the
+ *                      value.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - RTERR_BADVALUE if nsecs is out of range or the
+ *                        year does not fit the year field,
+ *                      - other negative return value is error.
+ */
+EXTERNRT int rtxEpochToDateTime
+(OSINT64 secs, OSUINT32 nsecs, OSNumDateTime* dateTime);
+
+/**
+ * This function parses a GeneralizedTime string directly to seconds and
+ * nanoseconds since 1970-01-01 00:00:00 UTC. A time without a time zone
+ * is taken to be in UTC. Fraction digits after the ninth are ignored.
+ *
+ * @param pctxt       Pointer to context structure.
+ * @param value       Null-terminated GeneralizedTime string.
+ * @param pSecs       Pointer to variable to receive the number of seconds.
+ * @param pNsecs      Pointer to variable to receive the nanoseconds, or
+ *                      NULL if not required.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - negative return value is error.
+ */
+EXTERNRT int rtParseGeneralizedTimeEpoch
+(OSCTXT *pctxt, const char* value, OSINT64* pSecs, OSUINT32* pNsecs);
+
+/**
+ * This function parses a UTCTime string directly to seconds since
+ * 1970-01-01 00:00:00 UTC.
+ *
+ * @param pctxt       Pointer to context structure.
+ * @param value       Null-terminated UTCTime string.
+ * @param pSecs       Pointer to variable to receive the number of seconds.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - negative return value is error.
+ */
+EXTERNRT int rtParseUTCTimeEpoch
+(OSCTXT *pctxt, const char* value, OSINT64* pSecs);
+
+/**
+ * This function parses an array of GeneralizedTime strings as described
+ * for rtParseGeneralizedTimeEpoch. Parsing stops at the first invalid
+ * string; its index is added to the error parameters.
+ *
+ * @param pctxt       Pointer to context structure.
+ * @param values      Array of null-terminated GeneralizedTime strings.
+ * @param count       Number of strings.
+ * @param pSecs       Array to receive the number of seconds for each.
+ * @param pNsecs      Array to receive the nanoseconds for each, or NULL
+ *                      if not required.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - negative return value is error.
+ */
+EXTERNRT int rtParseGeneralizedTimeArray
+(OSCTXT *pctxt, const char* const* values, OSSIZE count,
+ OSINT64* pSecs, OSUINT32* pNsecs);
+
+/**
+ * This function parses an array of UTCTime strings as described for
+ * rtParseUTCTimeEpoch. Parsing stops at the first invalid string; its
+ * index is added to the error parameters.
+ *
+ * @param pctxt       Pointer to context structure.
+ * @param values      Array of null-terminated UTCTime strings.
+ * @param count       Number of strings.
+ * @param pSecs       Array to receive the number of seconds for each.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - negative return value is error.
+ */
+EXTERNRT int rtParseUTCTimeArray
+(OSCTXT *pctxt, const char* const* values, OSSIZE count, OSINT64* pSecs);
+
+/**
+ * This function formats a time given as seconds and nanoseconds since
+ * 1970-01-01 00:00:00 UTC as a GeneralizedTime string in the form
+ * required by DER: YYYYMMDDHHMMSS[.f]Z, with trailing zeros of the
+ * fraction removed.
+ *
+ * @param pctxt       Pointer to context structure.
+ * @param secs        Number of seconds since the epoch.
+ * @param nsecs       Nanoseconds (0 to 999999999).
+ * @param buffer      Buffer to receive the null-terminated string.
+ * @param bufsiz      Size of the buffer. 26 bytes is always enough.
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - negative return value is error.
+ */
+EXTERNRT int rtFormatGeneralizedTime
+(OSCTXT *pctxt, OSINT64 secs, OSUINT32 nsecs, char* buffer, size_t bufsiz);
+
+/**
+ * This function formats a time given as seconds since 1970-01-01 00:00:00
+ * UTC as a UTCTime string in the form required by DER: YYMMDDHHMMSSZ.
+ * The year must be in the range 1950 to 2049.
+ *
+ * @param pctxt       Pointer to context structure.
+ * @param secs        Number of seconds since the epoch.
+ * @param buffer      Buffer to receive the null-terminated string.
+ * @param bufsiz      Size of the buffer (at least 14 bytes).
+ * @return            Completion status of operation:
+ *                      - 0 = success,
+ *                      - negative return value is error.
+ */
+EXTERNRT int rtFormatUTCTime
+(OSCTXT *pctxt, OSINT64 secs, char* buffer, size_t bufsiz);
+
 /**
  * @} ccfDateTime
  */
@@ -63,6 +63,84 @@ EXTERNRT OSINT32 rtxLookupEnum
 EXTERNRT OSINT32 rtxLookupEnumByValue
 (OSINT32 value, const OSEnumItem enumTable[], size_t enumTableSize);
 
+/**
+ * Constant-time index over an enumeration table. Names are found with a
+ * minimal perfect hash, so a lookup compares at most one name. Values are
+ * found in a table indexed directly by value if the values are dense, or
+ * in a small hash table otherwise. Unlike rtxLookupEnum, the enumeration
+ * table does not need to be sorted. If names or values occur more than
+ * once, the first row is found.
+ *
+ * An index is normally built at startup with rtxEnumIndexInit. The arrays
+ * may also be generated as static data, in which case pctxt is NULL and
+ * rtxEnumIndexFree does nothing. Once built, an index may be searched from
+ * several threads at the same time.
+ */
+typedef struct OSEnumIndex {
+   OSCTXT*           pctxt;         /* context used for index memory     */
+   const OSEnumItem* enumTable;     /* indexed enumeration table         */
+   OSUINT32          seed;          /* name hash seed                    */
+   OSUINT32          nbuckets;      /* number of displacement buckets    */
+   OSUINT32          nnameSlots;    /* number of name slots              */
+   const OSUINT32*   displace;      /* displacement of each bucket       */
+   const OSUINT16*   nameSlots;     /* row index + 1, or 0 if empty      */
+   OSINT32           minValue;      /* smallest value in table           */
+   OSUINT32          nvalueSlots;   /* number of value slots             */
+   OSBOOL            denseValues;   /* slots indexed by value - minValue */
+   const OSUINT16*   valueSlots;    /* row index + 1, or 0 if empty      */
+} OSEnumIndex;
+
+/**
+ * This function builds an index over an enumeration table. The memory
+ * used by the index is allocated from the given context, which must
+ * remain valid until the index is freed. The table itself is not copied.
+ *
+ * @param pctxt Pointer to context structure.
+ * @param pIndex Pointer to index structure to initialize.
+ * @param enumTable Table containing the defined enumeration
+ * @param enumTableSize Number of rows in the table
+ * @return Completion status of operation:
+ *   - 0 = success,
+ *   - negative return value is error.
+ */
+EXTERNRT int rtxEnumIndexInit
+(OSCTXT* pctxt, OSEnumIndex* pIndex, const OSEnumItem enumTable[],
+ OSUINT16 enumTableSize);
+
+/**
+ * This function frees the memory used by an index built with
+ * rtxEnumIndexInit.
+ *
+ * @param pIndex Pointer to index structure.
+ */
+EXTERNRT void rtxEnumIndexFree (OSEnumIndex* pIndex);
+
+/**
+ * This function will return the index of the item with the given
+ * enumerated identifier string, as described for rtxLookupEnum.
+ *
+ * @param pIndex Index over the enumeration table.
+ * @param strValue Enumerated identifier value
+ * @param strValueSize Length of enumerated identifier, or (size_t)-1 if
+ *   it is null-terminated.
+ * @return Index to enumerated item if found; otherwise, negative
+ *   status code (RTERR_INVENUM).
+ */
+EXTERNRT OSINT32 rtxEnumIndexLookup
+(const OSEnumIndex* pIndex, const OSUTF8CHAR* strValue, size_t strValueSize);
+
+/**
+ * This function will return the index of the item with the given integer
+ * value, as described for rtxLookupEnumByValue.
+ *
+ * @param pIndex Index over the enumeration table.
+ * @param value  Integer value of the enumerated item.
+ * @return Index to enumerated item if found; otherwise, negative
+ *   status code (RTERR_INVENUM).
+ */
+EXTERNRT OSINT32 rtxEnumIndexLookupByValue
+(const OSEnumIndex* pIndex, OSINT32 value);
+
 /**
  * @} rtxEnum
  */
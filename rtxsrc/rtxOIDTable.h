@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+/**
+ * @file rtxOIDTable.h
+ * Interning table for object identifiers in encoded form.  Each distinct
+ * OID added to the table is given a small integer handle, which allows
+ * OID values to be compared with a single integer compare.
+ */
+#ifndef _RTXOIDTABLE_H_
+#define _RTXOIDTABLE_H_
+
+#include "rtxsrc/rtxCommon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rtxOIDTable OID interning table
+ * @{
+ *
+ * Handles are numbered from 1 in the order OIDs are added; 0 is never a
+ * valid handle. Once all OIDs have been added, the table may be searched
+ * from several threads at the same time.
+ */
+typedef struct {
+   const OSOCTET* data;         /* contents octets (owned by table)     */
+   OSUINT32     numocts;        /* number of contents octets            */
+   OSUINT32     hash;           /* hash of contents octets              */
+} OSRTOIDTableEntry;
+
+typedef struct OSRTOIDTable {
+   OSCTXT*      pctxt;          /* context used for table memory        */
+   OSRTOIDTableEntry* entries;  /* entry for handle h is entries[h-1]   */
+   OSUINT32     count;          /* number of entries                    */
+   OSUINT32     capacity;       /* allocated number of entries          */
+   OSUINT32*    buckets;        /* hash buckets holding handles         */
+   OSUINT32     nbuckets;       /* number of buckets (power of 2)       */
+} OSRTOIDTable;
+
+/**
+ * This function initializes an OID table. All memory used by the table is
+ * allocated from the given context, which must remain valid until the
+ * table is freed.
+ *
+ * @param pctxt        Pointer to context structure.
+ * @param pTable       Pointer to table to initialize.
+ * @return             Completion status of operation:
+ *                       - 0 = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxOIDTableInit (OSCTXT* pctxt, OSRTOIDTable* pTable);
+
+/**
+ * This function frees all memory held by an OID table.
+ *
+ * @param pTable       Pointer to table.
+ */
+EXTERNRT void rtxOIDTableFree (OSRTOIDTable* pTable);
+
+/**
+ * This function adds an OID in encoded form to the table. The contents
+ * octets are copied. If the OID is already in the table, the existing
+ * handle is returned.
+ *
+ * @param pTable       Pointer to table.
+ * @param data         Contents octets of the encoded OID.
+ * @param numocts      Number of contents octets.
+ * @param pHandle      Pointer to variable to receive the handle.
+ * @return             Completion status of operation:
+ *                       - 0 = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxOIDTableAdd
+(OSRTOIDTable* pTable, const OSOCTET* data, OSUINT32 numocts,
+ OSUINT32* pHandle);
+
+/**
+ * This function adds an OID given as a list of subidentifiers to the
+ * table. It is converted to encoded form as described for rtxOIDTableAdd.
+ *
+ * @param pTable       Pointer to table.
+ * @param pOID         Pointer to OID value.
+ * @param pHandle      Pointer to variable to receive the handle.
+ * @return             Completion status of operation:
+ *                       - 0 = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxOIDTableAddObjId
+(OSRTOIDTable* pTable, const ASN1OBJID* pOID, OSUINT32* pHandle);
+
+/**
+ * This function looks up an OID in encoded form in the table.
+ *
+ * @param pTable       Pointer to table.
+ * @param data         Contents octets of the encoded OID.
+ * @param numocts      Number of contents octets.
+ * @return             Handle of the OID or 0 if it is not in the table.
+ */
+EXTERNRT OSUINT32 rtxOIDTableFind
+(const OSRTOIDTable* pTable, const OSOCTET* data, OSUINT32 numocts);
+
+/**
+ * This function returns the OID with the given handle. The returned value
+ * references the contents octets held by the table.
+ *
+ * @param pTable       Pointer to table.
+ * @param handle       Handle of the OID.
+ * @param pOID         Pointer to variable to receive the OID.
+ * @return             Completion status of operation:
+ *                       - 0 = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxOIDTableGet
+(const OSRTOIDTable* pTable, OSUINT32 handle, ASN1EncOID* pOID);
+
+/**
+ * @} rtxOIDTable
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
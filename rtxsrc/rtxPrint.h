@@ -25,10 +25,153 @@
 
 #define OSRTINDENTSPACES        3       /* number of spaces for indent  */
 
+/* Print sink flags */
+
+#define OSRTPRINT_AUTOFLUSH     0x01    /* write output after each call */
+#define OSRTPRINT_JSON          0x02    /* print values as JSON lines   */
+
+#ifndef OSRTPRINT_BUFSIZE
+#define OSRTPRINT_BUFSIZE       4096    /* default sink buffer size     */
+#endif
+#define OSRTPRINT_MINBUFSIZE    256
+#define OSRTPRINT_JSONDEPTH     32      /* JSON objects checked for
+                                           repeated member names        */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @defgroup printSink Print Output Sinks
+ * @{
+ *
+ * The print functions write their output to the print sink of the calling
+ * thread. Output is formatted into the buffer of the sink and written to
+ * its file in large blocks, so threads printing at the same time do not
+ * interleave within a value. Each sink also holds the indentation level
+ * used for brace text printing.
+ *
+ * Unless another sink is set, each thread prints to its own default sink
+ * for stdout. That sink has the OSRTPRINT_AUTOFLUSH flag set so that its
+ * output stays in order with output written to stdout by other means.
+ *
+ * A sink with the OSRTPRINT_JSON flag set prints values as compact JSON
+ * instead of text. Each value printed outside of braces, such as a record
+ * from rtxPrintOpenBrace to the matching rtxPrintCloseBrace, becomes one
+ * line holding an object with a member of the given name. Strings are
+ * written as UTF-8 and binary data as hex strings; bit strings become an
+ * object with numbits and data members. Indentation is not printed.
+ * Consecutive members of an object with the same name, such as the
+ * elements of a SEQUENCE OF, become a single member holding an array.
+ * A JSON sink keeps the line being built in its buffer until the line is
+ * complete, growing the buffer if needed. The default sink for stdout has
+ * a fixed buffer; names of members written out before their object was
+ * complete are not grouped.
+ *
+ * Records are only grouped into lines by braces, so JSON output requires
+ * print functions that use brace text. Print functions that print each
+ * field under a dotted name such as "rec.name.givenName" produce one
+ * line for each field.
+ */
+
+/* State of an open JSON object */
+
+typedef struct OSRTPrintJSONLevel {
+   OSSIZE    keyOff;            /* offset of the last member name       */
+   OSSIZE    keyLen;            /* length of that name, or 0 if unknown */
+   OSBOOL    inArray;           /* members of that name form an array   */
+} OSRTPrintJSONLevel;
+
+typedef struct OSRTPrintSink {
+   char*     data;              /* buffered or collected output         */
+   OSSIZE    length;            /* number of bytes in data              */
+   OSSIZE    capacity;          /* size of the data buffer              */
+   FILE*     fp;                /* output file, or 0 to collect output  */
+   OSUINT32  indent;            /* current indentation in spaces        */
+   OSUINT32  flags;             /* OSRTPRINT_* flags                    */
+   int       status;            /* first error writing or collecting    */
+   OSBOOL    needSep;           /* JSON: a member precedes the next one */
+   OSSIZE    lineStart;         /* JSON: offset of the line being built */
+   OSRTPrintJSONLevel jsonLevels[OSRTPRINT_JSONDEPTH];
+} OSRTPrintSink;
+
+/**
+ * This function initializes a print sink. A sink for a file writes its
+ * buffer to the file whenever it fills up. A sink without a file collects
+ * all output in memory: the buffer grows as needed and holds
+ * null-terminated text in the data and length members.
+ *
+ * @param pSink        Pointer to the print sink to initialize.
+ * @param fp           Output file, or NULL to collect output in memory.
+ * @param bufsiz       Initial size of the buffer, or 0 to use
+ *                       OSRTPRINT_BUFSIZE.
+ * @param flags        OSRTPRINT_AUTOFLUSH and/or OSRTPRINT_JSON, or 0.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxPrintSinkInit
+(OSRTPrintSink* pSink, FILE* fp, OSSIZE bufsiz, OSUINT32 flags);
+
+/**
+ * This function writes the output buffered in a print sink to its file.
+ * The output collected by a sink without a file is kept.
+ *
+ * @param pSink        Pointer to the print sink.
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error. This is the
+ *                         first error that occurred since the sink was
+ *                         initialized.
+ */
+EXTERNRT int rtxPrintSinkFlush (OSRTPrintSink* pSink);
+
+/**
+ * This function discards the output collected by a print sink without a
+ * file and clears its error status.
+ *
+ * @param pSink        Pointer to the print sink.
+ */
+EXTERNRT void rtxPrintSinkReset (OSRTPrintSink* pSink);
+
+/**
+ * This function flushes a print sink and frees its buffer. The sink must
+ * no longer be set for any thread.
+ *
+ * @param pSink        Pointer to the print sink.
+ */
+EXTERNRT void rtxPrintSinkFree (OSRTPrintSink* pSink);
+
+/**
+ * This function sets the print sink of the calling thread.
+ *
+ * @param pSink        Pointer to the print sink, or NULL to restore the
+ *                       default sink for stdout.
+ * @return             Pointer to the sink that was previously set.
+ */
+EXTERNRT OSRTPrintSink* rtxPrintSetSink (OSRTPrintSink* pSink);
+
+/**
+ * This function returns the print sink of the calling thread.
+ *
+ * @return             Pointer to the current print sink.
+ */
+EXTERNRT OSRTPrintSink* rtxPrintGetSink (void);
+
+/**
+ * This function writes the output buffered in the print sink of the
+ * calling thread to its file.
+ *
+ * @return             Completion status of operation:
+ *                       - 0 (ASN_OK) = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxPrintFlush (void);
+
+/**
+ * @} printSink
+ */
+
 /* Run-time print utility functions */
 
 /**
@@ -37,7 +180,8 @@ extern "C" {
  *
  * These functions simply print the output in a "name=value" format. The value
  * format is obtained by calling one of the ToString functions with the given
- * value.
+ * value. Output goes to the print sink of the calling thread, which is
+ * stdout unless another sink has been set using rtxPrintSetSink.
  */
 /**
  * Prints a boolean value to stdout.
@@ -63,6 +207,15 @@ EXTERNRT void rtxPrintInteger (const char* name, OSINT32 value);
  */
 EXTERNRT void rtxPrintUnsigned (const char* name, OSUINT32 value);
 
+/**
+ * Prints a big integer value in binary sign-magnitude form to stdout as a
+ * hexadecimal number with a '0x' prefix, preceded by '-' if negative.
+ *
+ * @param name         The name of the variable to print.
+ * @param pvalue       Pointer to big integer value to print.
+ */
+EXTERNRT void rtxPrintBigInt (const char* name, const ASN1BigInt* pvalue);
+
 /**
  * This function prints the value of a binary string in hex format
  * to standard output.  If the string is 32 bytes or less, it is printed
@@ -143,7 +296,8 @@ EXTERNRT void rtxPrintNull (const char* name);
 EXTERNRT void rtxPrintNVP (const char* name, const OSUTF8NVP* value);
 
 /**
- * This function prints indentation spaces to stdout.
+ * This function prints indentation spaces to stdout. The indentation
+ * level is kept in the print sink of the calling thread.
  */
 EXTERNRT void rtxPrintIndent (void);
 
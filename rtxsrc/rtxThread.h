@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+/**
+ * @file rtxThread.h
+ * Minimal portable thread, mutex and condition variable functions used by
+ * the multi-threaded decode functions.  POSIX threads are used on all
+ * platforms other than Windows.
+ */
+#ifndef _RTXTHREAD_H_
+#define _RTXTHREAD_H_
+
+#include "rtxsrc/rtxCommon.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup rtxThread Thread functions
+ * @{
+ */
+#ifdef _WIN32
+typedef HANDLE             OSRTThread;
+typedef CRITICAL_SECTION   OSRTMutex;
+typedef CONDITION_VARIABLE OSRTCondVar;
+#else
+typedef pthread_t          OSRTThread;
+typedef pthread_mutex_t    OSRTMutex;
+typedef pthread_cond_t     OSRTCondVar;
+#endif
+
+/* Thread entry point function */
+
+typedef void (*OSRTThreadFunc) (void* pArg);
+
+/**
+ * This function starts a new thread running the given function.
+ *
+ * @param pThread      Pointer to variable to receive the thread handle.
+ * @param func         Thread entry point function.
+ * @param pArg         Argument passed to the entry point function.
+ * @return             Completion status of operation:
+ *                       - 0 = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxThreadCreate
+(OSRTThread* pThread, OSRTThreadFunc func, void* pArg);
+
+/**
+ * This function waits for a thread started with rtxThreadCreate to
+ * terminate and releases the thread handle.
+ *
+ * @param pThread      Pointer to thread handle.
+ * @return             Completion status of operation:
+ *                       - 0 = success,
+ *                       - negative return value is error.
+ */
+EXTERNRT int rtxThreadJoin (OSRTThread* pThread);
+
+/**
+ * This function returns the number of processors available to the
+ * process or 1 if this cannot be determined.
+ *
+ * @return             Number of available processors.
+ */
+EXTERNRT int rtxGetNumProcessors (void);
+
+EXTERNRT int  rtxMutexInit (OSRTMutex* pMutex);
+EXTERNRT void rtxMutexLock (OSRTMutex* pMutex);
+EXTERNRT void rtxMutexUnlock (OSRTMutex* pMutex);
+EXTERNRT void rtxMutexFree (OSRTMutex* pMutex);
+
+EXTERNRT int  rtxCondVarInit (OSRTCondVar* pCondVar);
+EXTERNRT void rtxCondVarWait (OSRTCondVar* pCondVar, OSRTMutex* pMutex);
+EXTERNRT void rtxCondVarSignal (OSRTCondVar* pCondVar);
+EXTERNRT void rtxCondVarBroadcast (OSRTCondVar* pCondVar);
+EXTERNRT void rtxCondVarFree (OSRTCondVar* pCondVar);
+
+/**
+ * @} rtxThread
+ */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -214,6 +214,18 @@ typedef struct {        /* object identifier */
    OSUINT32     subid[ASN_K_MAXSUBIDS];
 } ASN1OBJID;
 
+typedef struct {        /* object identifier in encoded form */
+   OSUINT32     numocts;        /* number of contents octets            */
+   OSUINT32     handle;         /* interned handle or 0 if not known    */
+   const OSOCTET* data;         /* contents octets of the encoding      */
+} ASN1EncOID;
+
+typedef struct {        /* big integer in binary sign-magnitude form */
+   OSUINT32     numocts;        /* number of magnitude octets           */
+   OSBOOL       negative;       /* value is less than zero              */
+   const OSOCTET* data;         /* magnitude, most significant first    */
+} ASN1BigInt;
+
 typedef struct {
    OSUINT32       nchars;
    OSUNICHAR*     data;
@@ -0,0 +1,183 @@
+/**
+ * Copyright (c) 1997-2025 by Objective Systems, Inc.
+ * http://www.obj-sys.com
+ *
+ * This software is furnished under an open source license and may be
+ * used and copied only in accordance with the terms of this license.
+ * The text of the license may generally be found in the root
+ * directory of this installation in the COPYING file.  It
+ * can also be viewed online at the following URL:
+ *
+ *   http://www.obj-sys.com/open/lgpl2.html
+ *
+ * Any redistributions of this file including modified versions must
+ * maintain this copyright notice.
+ *
+ *****************************************************************************/
+
+#include <stdlib.h>
+#include "rtxsrc/rtxThread.h"
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+/* The entry point and its argument are passed to the native thread    */
+/* start routine in a heap record, which the new thread releases.      */
+
+typedef struct {
+   OSRTThreadFunc func;
+   void*          pArg;
+} OSRTThreadStart;
+
+#ifdef _WIN32
+static DWORD WINAPI threadStart (LPVOID pStartArg)
+#else
+static void* threadStart (void* pStartArg)
+#endif
+{
+   OSRTThreadStart start = *(OSRTThreadStart*)pStartArg;
+   free (pStartArg);
+
+   start.func (start.pArg);
+
+   return 0;
+}
+
+int rtxThreadCreate (OSRTThread* pThread, OSRTThreadFunc func, void* pArg)
+{
+   OSRTThreadStart* pStart;
+
+   if (0 == pThread || 0 == func) return RTERR_NULLPTR;
+
+   pStart = (OSRTThreadStart*) malloc (sizeof(OSRTThreadStart));
+   if (0 == pStart) return RTERR_NOMEM;
+
+   pStart->func = func;
+   pStart->pArg = pArg;
+
+#ifdef _WIN32
+   *pThread = CreateThread (NULL, 0, threadStart, pStart, 0, NULL);
+   if (NULL == *pThread) {
+      free (pStart);
+      return RTERR_NOMEM;
+   }
+#else
+   if (0 != pthread_create (pThread, NULL, threadStart, pStart)) {
+      free (pStart);
+      return RTERR_NOMEM;
+   }
+#endif
+
+   return 0;
+}
+
+int rtxThreadJoin (OSRTThread* pThread)
+{
+#ifdef _WIN32
+   if (WAIT_OBJECT_0 != WaitForSingleObject (*pThread, INFINITE))
+      return RTERR_ILLSTATE;
+   CloseHandle (*pThread);
+#else
+   if (0 != pthread_join (*pThread, NULL))
+      return RTERR_ILLSTATE;
+#endif
+   return 0;
+}
+
+int rtxGetNumProcessors (void)
+{
+#ifdef _WIN32
+   SYSTEM_INFO sysInfo;
+   GetSystemInfo (&sysInfo);
+   return (sysInfo.dwNumberOfProcessors > 0) ?
+      (int)sysInfo.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+   long nprocs = sysconf (_SC_NPROCESSORS_ONLN);
+   return (nprocs > 0) ? (int)nprocs : 1;
+#else
+   return 1;
+#endif
+}
+
+int rtxMutexInit (OSRTMutex* pMutex)
+{
+#ifdef _WIN32
+   InitializeCriticalSection (pMutex);
+   return 0;
+#else
+   return (0 == pthread_mutex_init (pMutex, NULL)) ? 0 : RTERR_NOMEM;
+#endif
+}
+
+void rtxMutexLock (OSRTMutex* pMutex)
+{
+#ifdef _WIN32
+   EnterCriticalSection (pMutex);
+#else
+   pthread_mutex_lock (pMutex);
+#endif
+}
+
+void rtxMutexUnlock (OSRTMutex* pMutex)
+{
+#ifdef _WIN32
+   LeaveCriticalSection (pMutex);
+#else
+   pthread_mutex_unlock (pMutex);
+#endif
+}
+
+void rtxMutexFree (OSRTMutex* pMutex)
+{
+#ifdef _WIN32
+   DeleteCriticalSection (pMutex);
+#else
+   pthread_mutex_destroy (pMutex);
+#endif
+}
+
+int rtxCondVarInit (OSRTCondVar* pCondVar)
+{
+#ifdef _WIN32
+   InitializeConditionVariable (pCondVar);
+   return 0;
+#else
+   return (0 == pthread_cond_init (pCondVar, NULL)) ? 0 : RTERR_NOMEM;
+#endif
+}
+
+void rtxCondVarWait (OSRTCondVar* pCondVar, OSRTMutex* pMutex)
+{
+#ifdef _WIN32
+   SleepConditionVariableCS (pCondVar, pMutex, INFINITE);
+#else
+   pthread_cond_wait (pCondVar, pMutex);
+#endif
+}
+
+void rtxCondVarSignal (OSRTCondVar* pCondVar)
+{
+#ifdef _WIN32
+   WakeConditionVariable (pCondVar);
+#else
+   pthread_cond_signal (pCondVar);
+#endif
+}
+
+void rtxCondVarBroadcast (OSRTCondVar* pCondVar)
+{
+#ifdef _WIN32
+   WakeAllConditionVariable (pCondVar);
+#else
+   pthread_cond_broadcast (pCondVar);
+#endif
+}
+
+void rtxCondVarFree (OSRTCondVar* pCondVar)
+{
+#ifdef _WIN32
+   (void)pCondVar; /* nothing to release */
+#else
+   pthread_cond_destroy (pCondVar);
+#endif
+}
@@ -19,56 +19,500 @@
 #include <string.h>
 #include "rtxsrc/rtxCommon.h"
 
-int rtxUTF8Len (const OSUTF8CHAR* inbuf)
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RTUTF8_SSE2
+#endif
+
+/* Character sets checked by rtValidateStr */
+
+#define CS_NUMERIC      0x01
+#define CS_PRINTABLE    0x02
+#define CS_VISIBLE      0x04
+#define CS_IA5          0x08
+#define CS_UTF8         0x10
+
+/* Character set membership of each 7-bit character */
+
+static const OSOCTET charSetTable[128] = {
+   0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+   0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+   0x0f, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c, 0x0e, 0x0e, 0x0e, 0x0c, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e,
+   0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0f, 0x0e, 0x0c, 0x0c, 0x0e, 0x0c, 0x0e,
+   0x0c, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e,
+   0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0c, 0x0c, 0x0c, 0x0c, 0x0c,
+   0x0c, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e,
+   0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0e, 0x0c, 0x0c, 0x0c, 0x0c, 0x08
+} ;
+
+/* Universal tag ID codes of the restricted character string types */
+
+static int charSetOfTag (OSUINT32 tag)
+{
+   /* Only universal class tags identify a string type */
+   if (tag & 0xC0000000) return 0;
+
+   switch (tag & 0x1FFFFFFF) {
+   case 12: return CS_UTF8;             /* UTF8String           */
+   case 18: return CS_NUMERIC;          /* NumericString        */
+   case 19: return CS_PRINTABLE;        /* PrintableString      */
+   case 22: return CS_IA5;              /* IA5String            */
+   case 26: return CS_VISIBLE;          /* VisibleString        */
+   default: return 0;
+   }
+}
+
+/* Length of the well-formed UTF-8 sequence at p (RFC 3629), or 0 if it */
+/* is invalid, overlong, a surrogate or beyond U+10FFFF.                */
+
+static size_t utf8SeqLen (const OSOCTET* p, size_t avail)
 {
-   size_t inlen = rtxUTF8LenBytes (inbuf);
-   size_t inbufx = 0;
-   int nbytes, nchars = 0;
-   OSOCTET byte;
+   OSOCTET b = p[0], lo = 0x80, hi = 0xBF;
+   size_t  n, i;
 
-   while (inbufx < inlen) {
+   if (b < 0x80) return 1;
+   else if (b < 0xC2) return 0;
+   else if (b < 0xE0) n = 2;
+   else if (b < 0xF0) {
+      n = 3;
+      if (b == 0xE0) lo = 0xA0;
+      else if (b == 0xED) hi = 0x9F;
+   }
+   else if (b < 0xF5) {
+      n = 4;
+      if (b == 0xF0) lo = 0x90;
+      else if (b == 0xF4) hi = 0x8F;
+   }
+   else return 0;
 
-      /* Process the first byte of the UTF-8 sequence */
+   if (n > avail || p[1] < lo || p[1] > hi) return 0;
 
-      byte = inbuf[inbufx++];
-      if (byte < 0x80) {
-         nbytes = 0;
-      }
-      else if ((byte & 0xe0) == 0xc0) {
-         nbytes = 1;
+   for (i = 2; i < n; i++) {
+      if ((p[i] & 0xC0) != 0x80) return 0;
+   }
+
+   return n;
+}
+
+/* Validate UTF-8 and optionally copy it.  Runs of ASCII characters are */
+/* checked a block at a time; other characters one sequence at a time. */
+
+static int copyUTF8
+(char* dest, const OSOCTET* src, size_t nbytes, size_t* pnchars)
+{
+   size_t i = 0, nchars = 0, end, len, k;
+
+   while (i < nbytes) {
+#ifdef RTUTF8_SSE2
+      if (nbytes - i >= 16) {
+         __m128i v = _mm_loadu_si128 ((const __m128i*)(src + i));
+         if (0 != dest) _mm_storeu_si128 ((__m128i*)(dest + i), v);
+         if (_mm_movemask_epi8 (v) == 0) {
+            i += 16; nchars += 16;
+            continue;
+         }
+         end = i + 16;
       }
-      else if ((byte & 0xf0) == 0xe0) {
-         nbytes = 2;
+      else end = nbytes;
+#else
+      if (nbytes - i >= sizeof(size_t)) {
+         size_t w;
+         memcpy (&w, src + i, sizeof(size_t));
+         if (0 != dest) memcpy (dest + i, &w, sizeof(size_t));
+         if ((w & (((size_t)-1 / 0xFF) * 0x80)) == 0) {
+            i += sizeof(size_t); nchars += sizeof(size_t);
+            continue;
+         }
+         end = i + sizeof(size_t);
       }
-      else if ((byte & 0xf8) == 0xf0) {
-         nbytes = 3;
+      else end = nbytes;
+#endif
+      /* The last sequence may extend past the end of the block */
+
+      while (i < end) {
+         len = utf8SeqLen (src + i, nbytes - i);
+         if (len == 0) return RTERR_INVUTF8;
+         if (0 != dest) {
+            for (k = 0; k < len; k++) dest[i + k] = (char)src[i + k];
+         }
+         i += len; nchars++;
       }
-      else if ((byte & 0xfc) == 0xf8) {
-         nbytes = 4;
+   }
+
+   if (0 != pnchars) *pnchars = nchars;
+   return 0;
+}
+
+#ifdef RTUTF8_SSE2
+#define IN_RANGE(v,lo,hi) \
+_mm_and_si128 (_mm_cmpgt_epi8 (v, _mm_set1_epi8 ((lo) - 1)), \
+               _mm_cmplt_epi8 (v, _mm_set1_epi8 ((hi) + 1)))
+
+#define IS_CHAR(v,c) _mm_cmpeq_epi8 (v, _mm_set1_epi8 (c))
+
+/* Bytes of a 16-byte block that are not in the character set; only    */
+/* the high bit of each byte is significant.                            */
+
+static __m128i charSetMiss (__m128i v, int charSet)
+{
+   __m128i ok;
+
+   switch (charSet) {
+   case CS_IA5:
+      return v;
+
+   case CS_VISIBLE:
+      return _mm_or_si128 (_mm_cmplt_epi8 (v, _mm_set1_epi8 (0x20)),
+                           IS_CHAR (v, 0x7F));
+
+   case CS_NUMERIC:
+      ok = _mm_or_si128 (IN_RANGE (v, '0', '9'), IS_CHAR (v, ' '));
+      break;
+
+   default: /* CS_PRINTABLE */
+      ok = _mm_or_si128
+         (_mm_or_si128 (IN_RANGE (v, 'A', 'Z'), IN_RANGE (v, 'a', 'z')),
+          _mm_or_si128 (IN_RANGE (v, '0', ':'), IN_RANGE (v, '\'', ')')));
+      ok = _mm_or_si128
+         (_mm_or_si128 (ok, IN_RANGE (v, '+', '/')),
+          _mm_or_si128 (_mm_or_si128 (IS_CHAR (v, ' '), IS_CHAR (v, '=')),
+                        IS_CHAR (v, '?')));
+      break;
+   }
+
+   return _mm_andnot_si128 (ok, _mm_set1_epi8 ((char)0x80));
+}
+#endif
+
+/* Check that all characters are in a 7-bit character set and           */
+/* optionally copy them.                                                */
+
+static int copyCharSet
+(char* dest, const OSOCTET* src, size_t nbytes, int charSet)
+{
+   size_t  i = 0;
+   OSOCTET bad = 0, c;
+
+#ifdef RTUTF8_SSE2
+   for (; i + 16 <= nbytes; i += 16) {
+      __m128i v = _mm_loadu_si128 ((const __m128i*)(src + i));
+      if (0 != dest) _mm_storeu_si128 ((__m128i*)(dest + i), v);
+      if (_mm_movemask_epi8 (charSetMiss (v, charSet)) != 0)
+         return RTERR_INVCHAR;
+   }
+#endif
+   for (; i < nbytes; i++) {
+      c = src[i];
+      if (0 != dest) dest[i] = (char)c;
+      bad |= (OSOCTET)((c >> 7) | ((charSetTable[c & 0x7F] & charSet) == 0));
+   }
+
+   return (bad) ? RTERR_INVCHAR : 0;
+}
+
+int rtxValidateUTF8 (const OSUTF8CHAR* inbuf, size_t nbytes)
+{
+   size_t nchars;
+   int stat;
+
+   if (0 == inbuf) return (nbytes == 0) ? 0 : RTERR_NULLPTR;
+
+   stat = copyUTF8 (0, inbuf, nbytes, &nchars);
+
+   return (stat != 0) ? stat : (int)nchars;
+}
+
+int rtxUTF8Len (const OSUTF8CHAR* inbuf)
+{
+   return rtxValidateUTF8 (inbuf, rtxUTF8LenBytes (inbuf));
+}
+
+size_t rtxUTF8LenBytes (const OSUTF8CHAR* inbuf)
+{
+   return (0 != inbuf) ? strlen ((const char*)inbuf) : 0;
+}
+
+/* Byte order conversion of BMP and UCS-4 characters.  The SSE2 paths   */
+/* assume a little-endian host, which is the case wherever SSE2 exists. */
+
+#ifdef RTUTF8_SSE2
+static __m128i swap16 (__m128i v)
+{
+   return _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+}
+
+static __m128i swap32 (__m128i v)
+{
+   v = swap16 (v);
+   return _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (v, 0xB1), 0xB1);
+}
+#endif
+
+void rtxBMPCharsFromBE (const OSOCTET* src, OSSIZE nchars, OSUNICHAR* dest)
+{
+   OSSIZE i = 0;
+
+#ifdef RTUTF8_SSE2
+   for (; i + 8 <= nchars; i += 8) {
+      __m128i v = _mm_loadu_si128 ((const __m128i*)(src + (2 * i)));
+      _mm_storeu_si128 ((__m128i*)(dest + i), swap16 (v));
+   }
+#endif
+   for (; i < nchars; i++) {
+      dest[i] = (OSUNICHAR)((src[2 * i] << 8) | src[2 * i + 1]);
+   }
+}
+
+void rtxBMPCharsToBE (const OSUNICHAR* src, OSSIZE nchars, OSOCTET* dest)
+{
+   OSSIZE i = 0;
+
+#ifdef RTUTF8_SSE2
+   for (; i + 8 <= nchars; i += 8) {
+      __m128i v = _mm_loadu_si128 ((const __m128i*)(src + i));
+      _mm_storeu_si128 ((__m128i*)(dest + (2 * i)), swap16 (v));
+   }
+#endif
+   for (; i < nchars; i++) {
+      OSUNICHAR c = src[i];
+      dest[2 * i] = (OSOCTET)(c >> 8);
+      dest[2 * i + 1] = (OSOCTET)c;
+   }
+}
+
+void rtxUCS4CharsFromBE (const OSOCTET* src, OSSIZE nchars, OS32BITCHAR* dest)
+{
+   OSSIZE i = 0;
+
+#ifdef RTUTF8_SSE2
+   for (; i + 4 <= nchars; i += 4) {
+      __m128i v = _mm_loadu_si128 ((const __m128i*)(src + (4 * i)));
+      _mm_storeu_si128 ((__m128i*)(dest + i), swap32 (v));
+   }
+#endif
+   for (; i < nchars; i++) {
+      const OSOCTET* p = src + (4 * i);
+      dest[i] = ((OS32BITCHAR)p[0] << 24) | ((OS32BITCHAR)p[1] << 16) |
+         ((OS32BITCHAR)p[2] << 8) | p[3];
+   }
+}
+
+void rtxUCS4CharsToBE (const OS32BITCHAR* src, OSSIZE nchars, OSOCTET* dest)
+{
+   OSSIZE i = 0;
+
+#ifdef RTUTF8_SSE2
+   for (; i + 4 <= nchars; i += 4) {
+      __m128i v = _mm_loadu_si128 ((const __m128i*)(src + i));
+      _mm_storeu_si128 ((__m128i*)(dest + (4 * i)), swap32 (v));
+   }
+#endif
+   for (; i < nchars; i++) {
+      OS32BITCHAR c = src[i];
+      OSOCTET* p = dest + (4 * i);
+      p[0] = (OSOCTET)(c >> 24);
+      p[1] = (OSOCTET)(c >> 16);
+      p[2] = (OSOCTET)(c >> 8);
+      p[3] = (OSOCTET)c;
+   }
+}
+
+/* Transcode big-endian characters of the given width (2 or 4 octets)  */
+/* to UTF-8.  If dest is null, only the length is computed.            */
+
+static int beToUTF8
+(const OSOCTET* src, size_t nbytes, size_t width, OSUTF8CHAR* dest,
+ size_t bufsiz)
+{
+   size_t   i = 0, n = 0, len;
+   OSUINT32 c;
+
+   if (0 == src && nbytes > 0) return RTERR_NULLPTR;
+   if (nbytes % width != 0) return RTERR_INVLEN;
+   if (0 != dest && bufsiz == 0) return RTERR_STROVFLW;
+
+   while (i < nbytes) {
+#ifdef RTUTF8_SSE2
+      /* Narrow a block of ASCII characters to one byte each */
+
+      if (nbytes - i >= 16 && (0 == dest || bufsiz - n > 16 / width)) {
+         __m128i v = _mm_loadu_si128 ((const __m128i*)(src + i));
+         __m128i zero = _mm_setzero_si128 ();
+
+         if (width == 2) {
+            v = swap16 (v);
+            if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_and_si128
+                (v, _mm_set1_epi16 ((short)0xFF80)), zero)) == 0xFFFF) {
+               if (0 != dest) {
+                  _mm_storel_epi64 ((__m128i*)(dest + n),
+                                    _mm_packus_epi16 (v, v));
+               }
+               i += 16; n += 8;
+               continue;
+            }
+         }
+         else {
+            v = swap32 (v);
+            if (_mm_movemask_epi8 (_mm_cmpeq_epi8 (_mm_and_si128
+                (v, _mm_set1_epi32 (~0x7F)), zero)) == 0xFFFF) {
+               if (0 != dest) {
+                  int w = _mm_cvtsi128_si32
+                     (_mm_packus_epi16 (_mm_packs_epi32 (v, v), zero));
+                  memcpy (dest + n, &w, 4);
+               }
+               i += 16; n += 4;
+               continue;
+            }
+         }
       }
-      else if ((byte & 0xfe) == 0xfc) {
-         nbytes = 5;
+#endif
+      if (width == 2) {
+         c = ((OSUINT32)src[i] << 8) | src[i + 1];
       }
       else {
-         return RTERR_INVUTF8; /* invalid encoding error */
+         c = ((OSUINT32)src[i] << 24) | ((OSUINT32)src[i + 1] << 16) |
+            ((OSUINT32)src[i + 2] << 8) | src[i + 3];
+      }
+      i += width;
+
+      /* Surrogates and values beyond U+10FFFF are not characters */
+
+      if (c < 0x80) len = 1;
+      else if (c < 0x800) len = 2;
+      else if (c < 0x10000) {
+         if (c >= 0xD800 && c <= 0xDFFF) return RTERR_INVCHAR;
+         len = 3;
       }
+      else if (c <= 0x10FFFF) len = 4;
+      else return RTERR_INVCHAR;
 
-      inbufx += nbytes;
-      nchars ++;
+      if (0 != dest) {
+         if (bufsiz - n <= len) return RTERR_STROVFLW;
+
+         switch (len) {
+         case 4:
+            dest[n + 3] = (OSUTF8CHAR)(0x80 | (c & 0x3F)); c >>= 6;
+            /* fall through */
+         case 3:
+            dest[n + 2] = (OSUTF8CHAR)(0x80 | (c & 0x3F)); c >>= 6;
+            /* fall through */
+         case 2:
+            dest[n + 1] = (OSUTF8CHAR)(0x80 | (c & 0x3F)); c >>= 6;
+            dest[n] = (OSUTF8CHAR)((0xF00 >> len) | c);
+            break;
+         default:
+            dest[n] = (OSUTF8CHAR)c;
+         }
+      }
+      n += len;
+      if (n > (size_t)OSINT32_MAX) return RTERR_TOOBIG;
    }
 
-   return (nchars);
+   if (0 != dest) dest[n] = '\0';
+
+   return (int)n;
 }
 
-size_t rtxUTF8LenBytes (const OSUTF8CHAR* inbuf)
+/* Transcode UTF-8 to big-endian characters of the given width (2 or 4 */
+/* octets).  If dest is null, only the length is computed.             */
+
+static int utf8ToBE
+(const OSUTF8CHAR* src, size_t nbytes, size_t width, OSOCTET* dest,
+ size_t bufsiz)
 {
-   size_t len = 0;
+   size_t   i = 0, n = 0, len, k;
+   OSUINT32 c;
+
+   if (0 == src && nbytes > 0) return RTERR_NULLPTR;
+
+   while (i < nbytes) {
+#ifdef RTUTF8_SSE2
+      /* Widen a block of ASCII characters */
+
+      if (nbytes - i >= 16 && (0 == dest || bufsiz - n >= 16 * width)) {
+         __m128i v = _mm_loadu_si128 ((const __m128i*)(src + i));
+
+         if (_mm_movemask_epi8 (v) == 0) {
+            if (0 != dest) {
+               __m128i zero = _mm_setzero_si128 ();
+               __m128i lo = _mm_unpacklo_epi8 (zero, v);
+               __m128i hi = _mm_unpackhi_epi8 (zero, v);
+
+               if (width == 2) {
+                  _mm_storeu_si128 ((__m128i*)(dest + n), lo);
+                  _mm_storeu_si128 ((__m128i*)(dest + n + 16), hi);
+               }
+               else {
+                  _mm_storeu_si128 ((__m128i*)(dest + n),
+                                    _mm_unpacklo_epi16 (zero, lo));
+                  _mm_storeu_si128 ((__m128i*)(dest + n + 16),
+                                    _mm_unpackhi_epi16 (zero, lo));
+                  _mm_storeu_si128 ((__m128i*)(dest + n + 32),
+                                    _mm_unpacklo_epi16 (zero, hi));
+                  _mm_storeu_si128 ((__m128i*)(dest + n + 48),
+                                    _mm_unpackhi_epi16 (zero, hi));
+               }
+            }
+            i += 16; n += 16 * width;
+            if (n > (size_t)OSINT32_MAX) return RTERR_TOOBIG;
+            continue;
+         }
+      }
+#endif
+      len = utf8SeqLen (src + i, nbytes - i);
+      if (len == 0) return RTERR_INVUTF8;
+
+      c = (len == 1) ? src[i] : (src[i] & (0x7F >> len));
+      for (k = 1; k < len; k++) {
+         c = (c << 6) | (src[i + k] & 0x3F);
+      }
+      i += len;
 
-   if (0 != inbuf) {
-      while (0 != inbuf[len]) len++;
+      if (width == 2 && c > 0xFFFF) return RTERR_INVCHAR;
+
+      if (0 != dest) {
+         if (bufsiz - n < width) return RTERR_STROVFLW;
+
+         if (width == 2) {
+            dest[n] = (OSOCTET)(c >> 8);
+            dest[n + 1] = (OSOCTET)c;
+         }
+         else {
+            dest[n] = 0;
+            dest[n + 1] = (OSOCTET)(c >> 16);
+            dest[n + 2] = (OSOCTET)(c >> 8);
+            dest[n + 3] = (OSOCTET)c;
+         }
+      }
+      n += width;
+      if (n > (size_t)OSINT32_MAX) return RTERR_TOOBIG;
    }
 
-   return len;
+   return (int)n;
+}
+
+int rtxBMPToUTF8
+(const OSOCTET* src, size_t nbytes, OSUTF8CHAR* dest, size_t bufsiz)
+{
+   return beToUTF8 (src, nbytes, 2, dest, bufsiz);
+}
+
+int rtxUCS4ToUTF8
+(const OSOCTET* src, size_t nbytes, OSUTF8CHAR* dest, size_t bufsiz)
+{
+   return beToUTF8 (src, nbytes, 4, dest, bufsiz);
+}
+
+int rtxUTF8ToBMP
+(const OSUTF8CHAR* src, size_t nbytes, OSOCTET* dest, size_t bufsiz)
+{
+   return utf8ToBE (src, nbytes, 2, dest, bufsiz);
+}
+
+int rtxUTF8ToUCS4
+(const OSUTF8CHAR* src, size_t nbytes, OSOCTET* dest, size_t bufsiz)
+{
+   return utf8ToBE (src, nbytes, 4, dest, bufsiz);
 }
 
 const char* rtBMPToCString
@@ -99,9 +543,29 @@ const char* rtUCSToCString
    return cstring;
 }
 
-int rtValidateStr (OSUINT32 tag, const char *pdata)
+int rtValidateStrCopy
+(OSUINT32 tag, char* dest, const char* src, size_t nbytes)
 {
-   /* not supported in OO version */
+   int charSet = charSetOfTag (tag);
+
+   if (0 == src) return (nbytes == 0) ? 0 : RTERR_NULLPTR;
+
+   if (charSet == CS_UTF8) {
+      return copyUTF8 (dest, (const OSOCTET*)src, nbytes, 0);
+   }
+   else if (charSet != 0) {
+      return copyCharSet (dest, (const OSOCTET*)src, nbytes, charSet);
+   }
+   else if (0 != dest) {
+      memcpy (dest, src, nbytes);
+   }
+
    return 0;
 }
 
+int rtValidateStr (OSUINT32 tag, const char *pdata)
+{
+   if (0 == pdata) return RTERR_NULLPTR;
+
+   return rtValidateStrCopy (tag, 0, pdata, strlen (pdata));
+}
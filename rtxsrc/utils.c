@@ -51,6 +51,21 @@ OSBOOL rtCopyOID (const ASN1OBJID* srcOID, ASN1OBJID* dstOID)
    return TRUE;
 }
 
+/* Compare two OID's in encoded form for equality */
+
+OSBOOL rtEncOIDsEqual (const ASN1EncOID* pOID1, const ASN1EncOID* pOID2)
+{
+   if (pOID1->handle != 0 && pOID2->handle != 0) {
+      return (OSBOOL)(pOID1->handle == pOID2->handle);
+   }
+   else if (pOID1->numocts == pOID2->numocts) {
+      return (OSBOOL)(pOID1->numocts == 0 ||
+         0 == memcmp (pOID1->data, pOID2->data, pOID1->numocts));
+   }
+
+   return FALSE;
+}
+
 OSINT32 rtxLookupEnum
 (const OSUTF8CHAR* strValue, size_t strValueSize,
  const OSEnumItem enumTable[], OSUINT16 enumTableSize)
@@ -0,0 +1,231 @@
+/* This test program checks that xd_SeqOfElemsParallel decodes the same */
+/* list as xd_SeqOfElems and that all memory allocated by its threads   */
+/* ends up in the caller's context.                                     */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rtbersrc/asn1ber.h"
+
+#define NUMELEMS   5000
+#define NUMTHREADS 4
+
+static int decodeIA5String
+(OSCTXT* pctxt, void* pvalue, ASN1TagType tagging, int length)
+{
+   return xd_charstr
+      (pctxt, (const char**)pvalue, tagging, ASN_ID_IA5String, length);
+}
+
+/* Decode only the tag and length of an element, leaving its contents */
+
+static int decodeHeaderOnly
+(OSCTXT* pctxt, void* pvalue, ASN1TagType tagging, int length)
+{
+   ASN1TAG tag;
+
+   return xd_tag_len (pctxt, &tag, &length, XM_ADVANCE);
+}
+
+/* Encode a SEQUENCE OF IA5String holding "e0", "e1", ... */
+
+static size_t encodeSeqOf (OSOCTET* buf, OSBOOL indefLen)
+{
+   size_t n = indefLen ? 2 : 5, start = n, len;
+   char str[16];
+   int i, k;
+
+   for (i = 0; i < NUMELEMS; i++) {
+      k = sprintf (str, "e%d", i);
+      buf[n++] = ASN_ID_IA5String;
+      buf[n++] = (OSOCTET) k;
+      memcpy (buf + n, str, k);
+      n += k;
+   }
+
+   buf[0] = 0x30;
+   if (indefLen) {
+      buf[1] = 0x80;
+      buf[n++] = 0;
+      buf[n++] = 0;
+   }
+   else {
+      len = n - start;
+      buf[1] = 0x83;
+      buf[2] = (OSOCTET) (len >> 16);
+      buf[3] = (OSOCTET) (len >> 8);
+      buf[4] = (OSOCTET) len;
+   }
+
+   return n;
+}
+
+static int decodeSeqOf
+(OSCTXT* pctxt, OSRTDList* pList, OSOCTET* buf, size_t size,
+ OSBOOL parallel, XD_ELEMDECFUNC decFunc)
+{
+   ASN1TAG tag;
+   int length, stat;
+
+   rtxDListInit (pList);
+   rtxInitContextBuffer (pctxt, buf, size);
+
+   stat = xd_tag_len (pctxt, &tag, &length, XM_ADVANCE);
+   if (stat != 0) return stat;
+
+   return parallel ?
+      xd_SeqOfElemsParallel (pctxt, pList, sizeof(char*), length,
+                             decFunc, NUMTHREADS) :
+      xd_SeqOfElems (pctxt, pList, sizeof(char*), length, decFunc);
+}
+
+/* Decode both ways and compare the lists.  Then release every block of */
+/* the parallel result individually: the heap of the caller's context   */
+/* must hold exactly the node block and the strings.                    */
+
+static int testSeqOf (OSBOOL indefLen)
+{
+   static OSOCTET buf[NUMELEMS * 16];
+   OSCTXT serCtxt, parCtxt;
+   OSRTDList serList, parList;
+   OSRTDListNode *pSerNode, *pParNode;
+   const char* desc = indefLen ? "indefinite length" : "definite length";
+   size_t size = encodeSeqOf (buf, indefLen);
+   int stat, failed = 0;
+
+   rtInitContext (&serCtxt);
+   rtInitContext (&parCtxt);
+
+   stat = decodeSeqOf (&serCtxt, &serList, buf, size, FALSE, decodeIA5String);
+   if (stat != 0) {
+      printf ("%s: serial decode failed, status %d\n", desc, stat);
+      failed++;
+   }
+   stat = decodeSeqOf (&parCtxt, &parList, buf, size, TRUE, decodeIA5String);
+   if (stat != 0) {
+      printf ("%s: parallel decode failed, status %d\n", desc, stat);
+      failed++;
+   }
+   if (parCtxt.buffer.byteIndex != serCtxt.buffer.byteIndex) {
+      printf ("%s: parallel decode ends at %lu, serial at %lu\n", desc,
+              (unsigned long)parCtxt.buffer.byteIndex,
+              (unsigned long)serCtxt.buffer.byteIndex);
+      failed++;
+   }
+   if (parList.count != NUMELEMS || serList.count != NUMELEMS) {
+      printf ("%s: %lu elements decoded in parallel, %lu serially\n", desc,
+              (unsigned long)parList.count, (unsigned long)serList.count);
+      failed++;
+   }
+
+   pSerNode = serList.head;
+   pParNode = parList.head;
+   while (0 != pSerNode && 0 != pParNode) {
+      const char* serStr = *(const char**)pSerNode->data;
+      const char* parStr = *(const char**)pParNode->data;
+
+      if (0 == serStr || 0 == parStr || strcmp (serStr, parStr) != 0) {
+         printf ("%s: element '%s' decoded as '%s'\n", desc,
+                 serStr ? serStr : "", parStr ? parStr : "");
+         failed++;
+         break;
+      }
+      rtxMemFreePtr (&parCtxt, (void*)parStr);
+
+      pSerNode = pSerNode->next;
+      pParNode = pParNode->next;
+   }
+
+   if (0 != parList.head) {
+      OSOCTET* pblock = (OSOCTET*)parList.head - OSRTDLISTNODESIZE;
+      rtxMemFreePtr (&parCtxt, pblock);
+   }
+   if (failed == 0 && !rtxMemHeapIsEmpty (&parCtxt)) {
+      printf ("%s: blocks left in the heap after freeing the list\n", desc);
+      failed++;
+   }
+
+   rtFreeContext (&serCtxt);
+   rtFreeContext (&parCtxt);
+
+   return failed;
+}
+
+/* An element decode function that does not consume the whole element */
+/* must make the decode fail rather than go on out of step.            */
+
+static int testShortDecode (OSBOOL parallel)
+{
+   static OSOCTET buf[NUMELEMS * 16];
+   OSCTXT ctxt;
+   OSRTDList list;
+   const char* desc = parallel ? "parallel" : "serial";
+   size_t size = encodeSeqOf (buf, FALSE);
+   int stat, failed = 0;
+
+   rtInitContext (&ctxt);
+
+   stat = decodeSeqOf (&ctxt, &list, buf, size, parallel, decodeHeaderOnly);
+   if (stat != RTERR_BADVALUE) {
+      printf ("%s: short element decode returned status %d\n", desc, stat);
+      failed++;
+   }
+
+   rtFreeContext (&ctxt);
+
+   return failed;
+}
+
+/* Blocks moved by rtxMemHeapTransfer must be owned by the destination  */
+/* context alone.                                                       */
+
+static int testHeapTransfer ()
+{
+   OSCTXT srcCtxt, destCtxt;
+   void* ptrs[5];
+   int i, failed = 0;
+
+   rtInitContext (&srcCtxt);
+   rtInitContext (&destCtxt);
+
+   for (i = 0; i < 5; i++) {
+      ptrs[i] = rtxMemAlloc ((i < 2) ? &destCtxt : &srcCtxt, 16);
+   }
+
+   if (rtxMemHeapTransfer (&destCtxt, &srcCtxt) != 0 ||
+       !rtxMemHeapIsEmpty (&srcCtxt)) {
+      printf ("heap transfer: source heap not emptied\n");
+      failed++;
+   }
+
+   /* Free in an order that unlinks the old tail of each list */
+
+   rtxMemFreePtr (&destCtxt, ptrs[1]);
+   rtxMemFreePtr (&destCtxt, ptrs[4]);
+   rtxMemFreePtr (&destCtxt, ptrs[2]);
+   rtxMemFreePtr (&destCtxt, ptrs[0]);
+   ptrs[0] = rtxMemAlloc (&destCtxt, 16);
+   rtxMemFreePtr (&destCtxt, ptrs[3]);
+   rtxMemFreePtr (&destCtxt, ptrs[0]);
+
+   if (!rtxMemHeapIsEmpty (&destCtxt)) {
+      printf ("heap transfer: blocks left in the destination heap\n");
+      failed++;
+   }
+
+   rtFreeContext (&srcCtxt);
+   rtFreeContext (&destCtxt);
+
+   return failed;
+}
+
+int main (int argc, char** argv)
+{
+   int failed = testSeqOf (FALSE) + testSeqOf (TRUE) + testHeapTransfer ();
+
+   failed += testShortDecode (FALSE) + testShortDecode (TRUE);
+
+   printf ("%d parallel decode test failures\n", failed);
+
+   return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/* This test program decodes a PEM bundle with rtxPEMDecodeNext and     */
+/* checks that blocks following a corrupt block are still decoded.      */
+
+#include <stdio.h>
+#include <string.h>
+#include "rtxsrc/rtxCommon.h"
+
+typedef struct {
+   const char* label;           /* label of the block, null if invalid  */
+   const char* contents;
+} PEMTestBlock;
+
+static const char bundle[] =
+   "-----BEGIN ONE-----\n"
+   "b25l\n"
+   "-----END ONE-----\n"
+   "-----BEGIN BAD BODY-----\n"
+   "b2*l\n"
+   "-----END BAD BODY-----\n"
+   "-----BEGIN TWO-----\n"
+   "dHdv\n"
+   "-----END TWO-----\n"
+   "-----BEGIN NO END-----\n"
+   "bm8gZW5k\n"
+   "-----BEGIN THREE-----\n"
+   "dGhyZWU=\n"
+   "-----END THREE-----\n"
+   "-----BEGIN MISMATCH-----\n"
+   "bWlzbWF0Y2g=\n"
+   "-----END OTHER-----\n"
+   "-----BEGIN BAD LABEL\n"
+   "-----BEGIN FOUR-----\n"
+   "Zm91cg==\n"
+   "-----END FOUR-----\n";
+
+static const PEMTestBlock expected[] = {
+   { "ONE", "one" },
+   { 0, 0 },
+   { "TWO", "two" },
+   { 0, 0 },
+   { "THREE", "three" },
+   { 0, 0 },
+   { 0, 0 },
+   { "FOUR", "four" }
+} ;
+
+int main (int argc, char** argv)
+{
+   OSOCTET buf[sizeof(bundle)];
+   const char* label;
+   size_t offset = 0, labelLen, nblocks = sizeof(expected)/sizeof(expected[0]);
+   size_t i, prevOffset;
+   long stat;
+   int failures = 0;
+
+   for (i = 0; i < nblocks; i++) {
+      const PEMTestBlock* pBlock = &expected[i];
+
+      prevOffset = offset;
+      stat = rtxPEMDecodeNext (bundle, sizeof(bundle) - 1, &offset,
+                               buf, sizeof(buf), &label, &labelLen);
+
+      if (0 == pBlock->label) {
+         if (stat >= 0) {
+            printf ("block %lu: invalid block decoded\n", (unsigned long)i);
+            failures++;
+         }
+      }
+      else if (stat != (long)strlen (pBlock->contents) ||
+               0 != memcmp (buf, pBlock->contents, (size_t)stat) ||
+               labelLen != strlen (pBlock->label) ||
+               0 != memcmp (label, pBlock->label, labelLen)) {
+         printf ("block %lu: status %ld, expected %s\n",
+                 (unsigned long)i, stat, pBlock->label);
+         failures++;
+      }
+      if (offset <= prevOffset) {
+         printf ("block %lu: offset not advanced\n", (unsigned long)i);
+         failures++;
+         break;
+      }
+   }
+
+   stat = rtxPEMDecodeNext (bundle, sizeof(bundle) - 1, &offset,
+                            buf, sizeof(buf), 0, 0);
+   if (stat != RTERR_ENDOFBUF) {
+      printf ("end of bundle: status %ld\n", stat);
+      failures++;
+   }
+
+   printf ("%d PEM decode test failures\n", failures);
+
+   return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,466 @@
+/* This test program decodes many copies of the employee and allTypes   */
+/* sample records through the BER record decode pipeline and checks the */
+/* results against decoding the same records one after another.        */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rtbersrc/asn1berPipeline.h"
+
+#define NUMEMPLOYEES  20000
+#define NUMALLTYPES   1000
+#define NUMTHREADS    4
+#define ALLTYPESLOG   "../../sample/allTypes/good/writer.log"
+#define RECORDFILE    "pipeTest.ber"
+
+/* Employee.PersonnelRecord for John Smith, as encoded by the employee  */
+/* sample writer.  The employee number is varied per record.            */
+
+static const OSOCTET jSmith[] = {
+   0x60, 0x81, 0x85, 0x61, 0x10, 0x16, 0x04, 0x4A, 0x6F, 0x68, 0x6E, 0x16,
+   0x01, 0x50, 0x16, 0x05, 0x53, 0x6D, 0x69, 0x74, 0x68, 0xA0, 0x0A, 0x16,
+   0x08, 0x44, 0x69, 0x72, 0x65, 0x63, 0x74, 0x6F, 0x72, 0x42, 0x01, 0x33,
+   0xA1, 0x0A, 0x16, 0x08, 0x31, 0x39, 0x37, 0x31, 0x30, 0x39, 0x31, 0x37,
+   0xA2, 0x12, 0x61, 0x10, 0x16, 0x04, 0x4D, 0x61, 0x72, 0x79, 0x16, 0x01,
+   0x54, 0x16, 0x05, 0x53, 0x6D, 0x69, 0x74, 0x68, 0xA3, 0x42, 0x31, 0x1F,
+   0x61, 0x11, 0x16, 0x05, 0x52, 0x61, 0x6C, 0x70, 0x68, 0x16, 0x01, 0x54,
+   0x16, 0x05, 0x53, 0x6D, 0x69, 0x74, 0x68, 0xA0, 0x0A, 0x16, 0x08, 0x31,
+   0x39, 0x35, 0x37, 0x31, 0x31, 0x31, 0x31, 0x31, 0x1F, 0x61, 0x11, 0x16,
+   0x05, 0x53, 0x75, 0x73, 0x61, 0x6E, 0x16, 0x01, 0x42, 0x16, 0x05, 0x4A,
+   0x6F, 0x6E, 0x65, 0x73, 0xA0, 0x0A, 0x16, 0x08, 0x31, 0x39, 0x35, 0x39,
+   0x30, 0x37, 0x31, 0x37
+} ;
+
+#define JSMITH_NUMBER_OFFSET 35
+
+typedef struct {
+   const char* givenName;
+   const char* initial;
+   const char* familyName;
+} Name;
+
+typedef struct {
+   Name        name;
+   const char* dateOfBirth;
+} ChildInformation;
+
+typedef struct {
+   Name        name;
+   const char* title;
+   OSINT32     number;
+   const char* dateOfHire;
+   Name        nameOfSpouse;
+   OSRTDList   children;
+} PersonnelRecord;
+
+/* Each record is reduced to a hash of its decoded contents */
+
+typedef struct {
+   OSUINT32* hashes;
+   int*      status;
+   OSSIZE    count;
+} RecResults;
+
+static OSUINT32 hashBytes (OSUINT32 hash, const void* data, size_t nbytes)
+{
+   const OSOCTET* p = (const OSOCTET*) data;
+   size_t i;
+
+   for (i = 0; i < nbytes; i++) {
+      hash = (hash ^ p[i]) * 16777619u;
+   }
+   return hash;
+}
+
+static OSUINT32 hashStr (OSUINT32 hash, const char* str)
+{
+   return (0 == str) ? hash : hashBytes (hash, str, strlen (str) + 1);
+}
+
+/* Employee decode functions, written the way they are generated */
+
+static int decodeName
+(OSCTXT* pctxt, void* pvalue, ASN1TagType tagging, int length)
+{
+   Name* pName = (Name*) pvalue;
+   int stat;
+
+   if (tagging == ASN1EXPL) {
+      stat = xd_match1 (pctxt, 0x61, &length);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+
+   stat = xd_charstr (pctxt, &pName->givenName, ASN1EXPL,
+                      ASN_ID_IA5String, 0);
+   if (stat == 0) stat = xd_charstr
+      (pctxt, &pName->initial, ASN1EXPL, ASN_ID_IA5String, 0);
+   if (stat == 0) stat = xd_charstr
+      (pctxt, &pName->familyName, ASN1EXPL, ASN_ID_IA5String, 0);
+
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+   return 0;
+}
+
+static int decodeDate (OSCTXT* pctxt, OSOCTET tag, const char** pvalue)
+{
+   int length, stat;
+
+   stat = xd_match1 (pctxt, tag, &length);
+   if (stat == 0) stat = xd_charstr
+      (pctxt, pvalue, ASN1EXPL, ASN_ID_IA5String, length);
+
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+   return 0;
+}
+
+static int decodeChildInformation
+(OSCTXT* pctxt, void* pvalue, ASN1TagType tagging, int length)
+{
+   ChildInformation* pChild = (ChildInformation*) pvalue;
+   int stat;
+
+   if (tagging == ASN1EXPL) {
+      stat = xd_match1 (pctxt, 0x31, &length);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+
+   stat = decodeName (pctxt, &pChild->name, ASN1EXPL, 0);
+   if (stat == 0) stat = decodeDate (pctxt, 0xA0, &pChild->dateOfBirth);
+
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+   return 0;
+}
+
+static int decodePersonnelRecord
+(OSCTXT* pctxt, void* pvalue, ASN1TagType tagging, int length)
+{
+   PersonnelRecord* pRec = (PersonnelRecord*) pvalue;
+   int stat;
+
+   stat = xd_match1 (pctxt, 0x60, &length);
+   if (stat == 0) stat = decodeName (pctxt, &pRec->name, ASN1EXPL, 0);
+   if (stat == 0) stat = decodeDate (pctxt, 0xA0, &pRec->title);
+   if (stat == 0) stat = xd_match1 (pctxt, 0x42, &length);
+   if (stat == 0) stat = xd_integer (pctxt, &pRec->number, ASN1IMPL, length);
+   if (stat == 0) stat = decodeDate (pctxt, 0xA1, &pRec->dateOfHire);
+   if (stat == 0) stat = xd_match1 (pctxt, 0xA2, &length);
+   if (stat == 0) stat = decodeName
+      (pctxt, &pRec->nameOfSpouse, ASN1EXPL, 0);
+   if (stat == 0) stat = xd_match1 (pctxt, 0xA3, &length);
+   if (stat == 0) {
+      rtxDListInit (&pRec->children);
+      stat = xd_SeqOfElems (pctxt, &pRec->children,
+         sizeof(ChildInformation), length, decodeChildInformation);
+   }
+
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+   return 0;
+}
+
+static OSUINT32 hashName (OSUINT32 hash, const Name* pName)
+{
+   hash = hashStr (hash, pName->givenName);
+   hash = hashStr (hash, pName->initial);
+   return hashStr (hash, pName->familyName);
+}
+
+static OSUINT32 hashPersonnelRecord (const void* pvalue)
+{
+   const PersonnelRecord* pRec = (const PersonnelRecord*) pvalue;
+   const OSRTDListNode* pnode;
+   OSUINT32 hash = 2166136261u;
+
+   hash = hashName (hash, &pRec->name);
+   hash = hashStr (hash, pRec->title);
+   hash = hashBytes (hash, &pRec->number, sizeof(pRec->number));
+   hash = hashStr (hash, pRec->dateOfHire);
+   hash = hashName (hash, &pRec->nameOfSpouse);
+   for (pnode = pRec->children.head; 0 != pnode; pnode = pnode->next) {
+      const ChildInformation* pChild = (const ChildInformation*) pnode->data;
+      hash = hashName (hash, &pChild->name);
+      hash = hashStr (hash, pChild->dateOfBirth);
+   }
+   return hash;
+}
+
+/* The allTypes record is decoded into a list of all its elements, with */
+/* a copy of the contents of each primitive element.                    */
+
+typedef struct {
+   ASN1TAG   tag;
+   int       length;
+   OSOCTET*  data;
+} TLVItem;
+
+typedef struct {
+   OSRTDList items;
+} TLVRecord;
+
+static int decodeTLVContents (OSCTXT* pctxt, OSRTDList* pList, int length);
+
+static int decodeTLV (OSCTXT* pctxt, OSRTDList* pList)
+{
+   TLVItem* pItem;
+   int stat;
+
+   pItem = rtxMemAllocTypeZ (pctxt, TLVItem);
+   if (0 == pItem || 0 == rtxDListAppend (pctxt, pList, pItem))
+      return LOG_RTERR (pctxt, RTERR_NOMEM);
+
+   stat = xd_tag_len (pctxt, &pItem->tag, &pItem->length, XM_ADVANCE);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   if (pItem->tag & TM_CONS) {
+      stat = decodeTLVContents (pctxt, pList, pItem->length);
+   }
+   else if (pItem->length > 0) {
+      pItem->data = (OSOCTET*) rtxMemAlloc (pctxt, pItem->length);
+      if (0 == pItem->data) return LOG_RTERR (pctxt, RTERR_NOMEM);
+      stat = xd_memcpy (pctxt, pItem->data, pItem->length);
+   }
+
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+   return 0;
+}
+
+static int decodeTLVContents (OSCTXT* pctxt, OSRTDList* pList, int length)
+{
+   ASN1CCB ccb;
+   int stat;
+
+   ccb.len = length;
+   ccb.ptr = OSRTBUFPTR (pctxt);
+
+   while (!XD_CHKEND (pctxt, &ccb)) {
+      stat = decodeTLV (pctxt, pList);
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+
+   if (length == ASN_K_INDEFLEN) {
+      stat = xd_match1 (pctxt, 0, &length);   /* end-of-contents */
+      if (stat != 0) return LOG_RTERR (pctxt, stat);
+   }
+
+   return 0;
+}
+
+static int decodeTLVRecord
+(OSCTXT* pctxt, void* pvalue, ASN1TagType tagging, int length)
+{
+   TLVRecord* pRec = (TLVRecord*) pvalue;
+   int stat;
+
+   rtxDListInit (&pRec->items);
+
+   stat = decodeTLV (pctxt, &pRec->items);
+   if (stat != 0) return LOG_RTERR (pctxt, stat);
+
+   return 0;
+}
+
+static OSUINT32 hashTLVRecord (const void* pvalue)
+{
+   const TLVRecord* pRec = (const TLVRecord*) pvalue;
+   const OSRTDListNode* pnode;
+   OSUINT32 hash = 2166136261u;
+
+   for (pnode = pRec->items.head; 0 != pnode; pnode = pnode->next) {
+      const TLVItem* pItem = (const TLVItem*) pnode->data;
+      hash = hashBytes (hash, &pItem->tag, sizeof(pItem->tag));
+      hash = hashBytes (hash, &pItem->length, sizeof(pItem->length));
+      if (0 != pItem->data) hash = hashBytes (hash, pItem->data, pItem->length);
+   }
+   return hash;
+}
+
+/* Read the hex dump of the message from an allTypes writer log */
+
+static size_t readAllTypesLog (OSOCTET* buf, size_t bufsiz)
+{
+   FILE* fp = fopen (ALLTYPESLOG, "r");
+   char line[128];
+   size_t n = 0;
+   unsigned int byte;
+   int i, pos;
+
+   if (0 == fp) return 0;
+
+   if (0 != fgets (line, sizeof(line), fp) &&
+       0 == strncmp (line, "message =", 9)) {
+      while (0 != fgets (line, sizeof(line), fp)) {
+         for (i = 0; i < 16; i++) {
+            if (sscanf (line + (i * 3), "%2x%n", &byte, &pos) != 1 ||
+                pos != 2) break;
+            if (n == bufsiz) { n = 0; break; }
+            buf[n++] = (OSOCTET) byte;
+         }
+         if (i < 16) break;
+      }
+   }
+   fclose (fp);
+
+   return n;
+}
+
+/* Pipeline completion function */
+
+static OSUINT32 (*g_hashFunc) (const void* pvalue);
+
+static void recDone
+(void* pCbArg, OSCTXT* pctxt, void* pvalue, OSSIZE recnum, int status)
+{
+   RecResults* pResults = (RecResults*) pCbArg;
+
+   if (recnum < pResults->count) {
+      pResults->status[recnum] = status;
+      pResults->hashes[recnum] = (status == 0) ? g_hashFunc (pvalue) : 0;
+   }
+}
+
+/* Decode the records in turn on one context and then through the      */
+/* pipeline, ordered and unordered, and compare the results.           */
+
+static int testPipeline
+(const char* desc, const OSOCTET* data, size_t recsize, OSSIZE count,
+ XD_ELEMDECFUNC decFunc, size_t valueSize,
+ OSUINT32 (*hashFunc) (const void* pvalue))
+{
+   ASN1BerPipeline* pPipeline;
+   ASN1BerPipelineConfig config;
+   ASN1BerPipelineStats stats;
+   RecResults results;
+   OSUINT32* expected;
+   OSCTXT ctxt;
+   void* pvalue;
+   OSSIZE i;
+   FILE* fp;
+   int run, ordered, stat, failed = 0;
+
+   expected = (OSUINT32*) malloc (count * sizeof(OSUINT32));
+   results.hashes = (OSUINT32*) malloc (count * sizeof(OSUINT32));
+   results.status = (int*) malloc (count * sizeof(int));
+   results.count = count;
+   g_hashFunc = hashFunc;
+
+   rtInitContext (&ctxt);
+   for (i = 0; i < count; i++) {
+      rtxInitContextBuffer (&ctxt, data + (i * recsize), recsize);
+      pvalue = rtxMemAllocZ (&ctxt, valueSize);
+      stat = decFunc (&ctxt, pvalue, ASN1EXPL, 0);
+      if (stat != 0) {
+         printf ("%s: record %lu failed to decode, status %d\n", desc,
+                 (unsigned long)i, stat);
+         rtxErrPrint (&ctxt);
+         failed++;
+         break;
+      }
+      expected[i] = hashFunc (pvalue);
+      rtxMemFree (&ctxt);
+   }
+   rtFreeContext (&ctxt);
+
+   /* Decode unordered and ordered from the buffer, then ordered from */
+   /* a file, which is larger than the chunks it is read in.           */
+
+   fp = fopen (RECORDFILE, "wb");
+   if (0 == fp || fwrite (data, recsize, count, fp) != count) {
+      printf ("%s: cannot write %s\n", desc, RECORDFILE);
+      failed++;
+   }
+   if (0 != fp) fclose (fp);
+
+   for (run = 0; run < 3 && failed == 0; run++) {
+      ordered = (run > 0);
+
+      memset (&config, 0, sizeof(config));
+      config.numThreads = NUMTHREADS;
+      config.ordered = (OSBOOL) ordered;
+      config.valueSize = valueSize;
+      config.decFunc = decFunc;
+      config.doneFunc = recDone;
+      config.pCbArg = &results;
+
+      memset (results.hashes, 0, count * sizeof(OSUINT32));
+      for (i = 0; i < count; i++) results.status[i] = -1;
+
+      stat = berPipelineCreate (&pPipeline, &config);
+      if (stat == 0) stat = (run == 2) ?
+         berPipelineRunFile (pPipeline, RECORDFILE) :
+         berPipelineRunBuffer (pPipeline, data, recsize * count);
+      if (stat == 0) berPipelineGetStats (pPipeline, &stats);
+      if (0 != pPipeline) berPipelineFree (pPipeline);
+
+      if (stat != 0) {
+         printf ("%s: pipeline run failed, status %d\n", desc, stat);
+         failed++;
+         continue;
+      }
+      if (stats.records != count || stats.errors != 0 ||
+          stats.bytes != recsize * count) {
+         printf ("%s: pipeline decoded %lu records, %lu errors\n", desc,
+                 (unsigned long)stats.records, (unsigned long)stats.errors);
+         failed++;
+      }
+      for (i = 0; i < count; i++) {
+         if (results.status[i] != 0 || results.hashes[i] != expected[i]) {
+            printf ("%s, %s: record %lu differs from serial decode\n", desc,
+                    (run == 2) ? "file" : ordered ? "ordered" : "unordered",
+                    (unsigned long)i);
+            failed++;
+            break;
+         }
+      }
+   }
+
+   remove (RECORDFILE);
+
+   free (expected);
+   free (results.hashes);
+   free (results.status);
+
+   return failed;
+}
+
+int main (int argc, char** argv)
+{
+   static OSOCTET allTypes[16384];
+   OSOCTET* data;
+   size_t recsize, csOffset, i;
+   int failed = 0;
+
+   /* Employee records with employee numbers 0 to 127 */
+
+   data = (OSOCTET*) malloc (sizeof(jSmith) * NUMEMPLOYEES);
+   for (i = 0; i < NUMEMPLOYEES; i++) {
+      memcpy (data + (i * sizeof(jSmith)), jSmith, sizeof(jSmith));
+      data[(i * sizeof(jSmith)) + JSMITH_NUMBER_OFFSET] = (OSOCTET)(i % 128);
+   }
+   failed += testPipeline ("employee", data, sizeof(jSmith), NUMEMPLOYEES,
+      decodePersonnelRecord, sizeof(PersonnelRecord), hashPersonnelRecord);
+   free (data);
+
+   /* allTypes records with the first character of cs varied */
+
+   recsize = readAllTypesLog (allTypes, sizeof(allTypes));
+   for (csOffset = 0; csOffset + 6 < recsize; csOffset++) {
+      if (0 == memcmp (allTypes + csOffset, "ABCDEF", 6)) break;
+   }
+   if (recsize == 0 || csOffset + 6 >= recsize) {
+      printf ("allTypes: cannot read message from %s\n", ALLTYPESLOG);
+      failed++;
+   }
+   else {
+      data = (OSOCTET*) malloc (recsize * NUMALLTYPES);
+      for (i = 0; i < NUMALLTYPES; i++) {
+         memcpy (data + (i * recsize), allTypes, recsize);
+         data[(i * recsize) + csOffset] = (OSOCTET)('A' + (i % 26));
+      }
+      failed += testPipeline ("allTypes", data, recsize, NUMALLTYPES,
+         decodeTLVRecord, sizeof(TLVRecord), hashTLVRecord);
+      free (data);
+   }
+
+   printf ("%d pipeline test failures\n", failed);
+
+   return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+/* This test program prints the employee sample record as a JSON line   */
+/* with print functions written the way brace text print code is        */
+/* generated, and checks the result for memory and file sinks.          */
+
+#include <stdio.h>
+#include <string.h>
+#include "rtxsrc/rtxPrint.h"
+
+#define NUMRECS 200
+
+typedef struct {
+   const char* givenName;
+   const char* initial;
+   const char* familyName;
+} Name;
+
+typedef struct {
+   Name        name;
+   const char* dateOfBirth;
+} ChildInformation;
+
+typedef struct {
+   Name        name;
+   const char* title;
+   OSINT32     number;
+   const char* dateOfHire;
+   Name        nameOfSpouse;
+   OSSIZE      nchildren;
+   const ChildInformation* children;
+} PersonnelRecord;
+
+static const ChildInformation jSmithChildren[] = {
+   { { "Ralph", "T", "Smith" }, "19571111" },
+   { { "Susan", "B", "Jones" }, "19590717" }
+} ;
+
+static const PersonnelRecord jSmith = {
+   { "John", "P", "Smith" }, "Director", 51, "19710917",
+   { "Mary", "T", "Smith" }, 2, jSmithChildren
+} ;
+
+static const char* expected =
+   "{\"Employee\":{"
+   "\"name\":{\"givenName\":\"John\",\"initial\":\"P\","
+   "\"familyName\":\"Smith\"},"
+   "\"title\":\"Director\",\"number\":51,\"dateOfHire\":\"19710917\","
+   "\"nameOfSpouse\":{\"givenName\":\"Mary\",\"initial\":\"T\","
+   "\"familyName\":\"Smith\"},"
+   "\"children\":{\"element\":["
+   "{\"name\":{\"givenName\":\"Ralph\",\"initial\":\"T\","
+   "\"familyName\":\"Smith\"},\"dateOfBirth\":\"19571111\"},"
+   "{\"name\":{\"givenName\":\"Susan\",\"initial\":\"B\","
+   "\"familyName\":\"Jones\"},\"dateOfBirth\":\"19590717\"}]}}}\n";
+
+static void print_Name (const char* name, const Name* pvalue)
+{
+   rtxPrintOpenBrace (name);
+   rtxPrintIndent ();
+   rtxPrintCharStr ("givenName", pvalue->givenName);
+   rtxPrintIndent ();
+   rtxPrintCharStr ("initial", pvalue->initial);
+   rtxPrintIndent ();
+   rtxPrintCharStr ("familyName", pvalue->familyName);
+   rtxPrintCloseBrace ();
+}
+
+static void print_ChildInformation
+(const char* name, const ChildInformation* pvalue)
+{
+   rtxPrintOpenBrace (name);
+   print_Name ("name", &pvalue->name);
+   rtxPrintIndent ();
+   rtxPrintCharStr ("dateOfBirth", pvalue->dateOfBirth);
+   rtxPrintCloseBrace ();
+}
+
+static void print_PersonnelRecord
+(const char* name, const PersonnelRecord* pvalue)
+{
+   OSSIZE i;
+
+   rtxPrintOpenBrace (name);
+   print_Name ("name", &pvalue->name);
+   rtxPrintIndent ();
+   rtxPrintCharStr ("title", pvalue->title);
+   rtxPrintIndent ();
+   rtxPrintInteger ("number", pvalue->number);
+   rtxPrintIndent ();
+   rtxPrintCharStr ("dateOfHire", pvalue->dateOfHire);
+   print_Name ("nameOfSpouse", &pvalue->nameOfSpouse);
+   rtxPrintOpenBrace ("children");
+   for (i = 0; i < pvalue->nchildren; i++) {
+      print_ChildInformation ("element", &pvalue->children[i]);
+   }
+   rtxPrintCloseBrace ();
+   rtxPrintCloseBrace ();
+}
+
+/* Print one record to a memory sink and check the text */
+
+static int testMemorySink ()
+{
+   OSRTPrintSink sink;
+   int failed = 0;
+
+   rtxPrintSinkInit (&sink, 0, 0, OSRTPRINT_JSON);
+   rtxPrintSetSink (&sink);
+
+   print_PersonnelRecord ("Employee", &jSmith);
+
+   if (sink.status != 0 || 0 == sink.data ||
+       strcmp (sink.data, expected) != 0) {
+      printf ("memory sink: unexpected output\n%s", sink.data);
+      failed++;
+   }
+   if (0 != sink.data && strlen (sink.data) != sink.length) {
+      printf ("memory sink: text is not null-terminated\n");
+      failed++;
+   }
+
+   rtxPrintSetSink (0);
+   rtxPrintSinkFree (&sink);
+
+   return failed;
+}
+
+/* Print many records through a file sink whose buffer is smaller than  */
+/* a record and check that every line is complete.                      */
+
+static int testFileSink ()
+{
+   OSRTPrintSink sink;
+   FILE* fp = tmpfile ();
+   char line[1024];
+   size_t len = strlen (expected);
+   int i, nlines = 0, failed = 0;
+
+   if (0 == fp) {
+      printf ("file sink: tmpfile failed\n");
+      return 1;
+   }
+
+   rtxPrintSinkInit (&sink, fp, OSRTPRINT_MINBUFSIZE, OSRTPRINT_JSON);
+   rtxPrintSetSink (&sink);
+
+   for (i = 0; i < NUMRECS; i++) {
+      print_PersonnelRecord ("Employee", &jSmith);
+   }
+   rtxPrintSinkFlush (&sink);
+   if (sink.status != 0) {
+      printf ("file sink: status %d\n", sink.status);
+      failed++;
+   }
+
+   rtxPrintSetSink (0);
+   rtxPrintSinkFree (&sink);
+
+   rewind (fp);
+   while (0 != fgets (line, sizeof(line), fp)) {
+      if (strlen (line) != len || memcmp (line, expected, len) != 0) {
+         printf ("file sink: unexpected line %d\n%s", nlines + 1, line);
+         failed++;
+      }
+      nlines++;
+   }
+   fclose (fp);
+
+   if (nlines != NUMRECS) {
+      printf ("file sink: %d lines written, %d expected\n", nlines, NUMRECS);
+      failed++;
+   }
+
+   return failed;
+}
+
+int main (int argc, char** argv)
+{
+   int failed = testMemorySink () + testFileSink ();
+
+   printf ("%d JSON print test failures\n", failed);
+
+   return (failed == 0) ? 0 : 1;
+}
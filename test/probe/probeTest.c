@@ -0,0 +1,93 @@
+/* This test program checks that xd_probe leaves the error information  */
+/* in the context unchanged when the probed element is not found.       */
+
+#include <stdio.h>
+#include <string.h>
+#include "rtbersrc/asn1ber.h"
+
+typedef struct {
+   const char* desc;
+   OSOCTET     data[8];
+   size_t      size;
+   size_t      offset;          /* decode position of the probe         */
+   ASN1TAG     tag;             /* tag probed for                       */
+   OSOCTET     flags;
+   int         expected;
+} ProbeTestVector;
+
+static const ProbeTestVector vectors[] = {
+   { "probe at end of buffer",
+     { 0x02, 0x01, 0x05 }, 3, 3, TM_CTXT|0, XM_ADVANCE, RTERR_IDNOTFOU },
+   { "probe for other tag",
+     { 0x02, 0x01, 0x05 }, 3, 0, TM_CTXT|0, XM_ADVANCE, RTERR_IDNOTFOU },
+   { "seek to end of buffer",
+     { 0x02, 0x01, 0x05, 0x04, 0x00 }, 5, 0, TM_CTXT|0,
+     XM_ADVANCE|XM_SEEK, RTERR_IDNOTFOU },
+   { "probe at end-of-contents",
+     { 0x02, 0x01, 0x05, 0x00, 0x00 }, 5, 3, TM_CTXT|0, XM_ADVANCE,
+     RTERR_IDNOTFOU },
+   { "probe found",
+     { 0x02, 0x01, 0x05, 0x80, 0x00 }, 5, 3, TM_CTXT|0, XM_ADVANCE, 0 }
+} ;
+
+/* Probe once with no error recorded and once after an earlier error */
+
+static int testProbe (const ProbeTestVector* pVector, int priorStatus)
+{
+   OSCTXT ctxt;
+   ASN1ErrInfo errInfo;
+   int len, stat, failed = 0;
+
+   rtInitContext (&ctxt);
+   rtxInitContextBuffer (&ctxt, (OSOCTET*)pVector->data, pVector->size);
+   ctxt.buffer.byteIndex = pVector->offset;
+   if (priorStatus != 0) {
+      LOG_RTERR (&ctxt, priorStatus);
+      if (0 == ctxt.errInfo.first.module || 0 == ctxt.errInfo.first.lineno) {
+         printf ("%s: error location not recorded\n", pVector->desc);
+         failed++;
+      }
+   }
+
+   memcpy (&errInfo, &ctxt.errInfo, sizeof(errInfo));
+
+   stat = xd_probe (&ctxt, pVector->tag, &len, pVector->flags);
+   if (stat != pVector->expected) {
+      printf ("%s: status %d, expected %d\n", pVector->desc,
+              stat, pVector->expected);
+      failed++;
+   }
+   if (stat == RTERR_IDNOTFOU &&
+       ctxt.buffer.byteIndex != pVector->offset) {
+      printf ("%s: decode position moved\n", pVector->desc);
+      failed++;
+   }
+   if (ctxt.errInfo.status != errInfo.status ||
+       ctxt.errInfo.stkx != errInfo.stkx ||
+       ctxt.errInfo.first.module != errInfo.first.module ||
+       ctxt.errInfo.first.lineno != errInfo.first.lineno ||
+       memcmp (ctxt.errInfo.stack, errInfo.stack,
+               errInfo.stkx * sizeof(errInfo.stack[0])) != 0) {
+      printf ("%s: error information changed\n", pVector->desc);
+      failed++;
+   }
+
+   rtFreeContext (&ctxt);
+
+   return failed;
+}
+
+int main (int argc, char** argv)
+{
+   size_t i;
+   int failures = 0;
+
+   for (i = 0; i < sizeof(vectors)/sizeof(vectors[0]); i++) {
+      failures += testProbe (&vectors[i], 0);
+      failures += testProbe (&vectors[i], RTERR_BADVALUE);
+   }
+
+   printf ("%d xd_probe test failures\n", failures);
+
+   return (failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/* This test program checks xd_Validate against encodings that must be  */
+/* accepted or rejected.                                                */
+
+#include <stdio.h>
+#include <string.h>
+#include "rtbersrc/asn1ber.h"
+
+typedef struct {
+   const char* desc;
+   OSOCTET     data[16];
+   size_t      size;
+   OSUINT32    flags;
+   int         expected;
+} ValTestVector;
+
+static const ValTestVector vectors[] = {
+   { "DER SET [0] constructed before [1]",
+     { 0x31, 0x08, 0xA0, 0x03, 0x02, 0x01, 0x05, 0x81, 0x01, 0xFF },
+     10, XV_DER, 0 },
+   { "DER SET [1] before [0] constructed",
+     { 0x31, 0x08, 0x81, 0x01, 0xFF, 0xA0, 0x03, 0x02, 0x01, 0x05 },
+     10, XV_DER, RTERR_SEQORDER },
+   { "BER SET [1] before [0] constructed",
+     { 0x31, 0x08, 0x81, 0x01, 0xFF, 0xA0, 0x03, 0x02, 0x01, 0x05 },
+     10, 0, 0 },
+   { "DER SET universal before context",
+     { 0x31, 0x06, 0x02, 0x01, 0x01, 0x80, 0x01, 0x00 },
+     8, XV_DER, 0 },
+   { "DER SET context before universal",
+     { 0x31, 0x06, 0x80, 0x01, 0x00, 0x02, 0x01, 0x01 },
+     8, XV_DER, RTERR_SEQORDER },
+   { "DER SET application before context",
+     { 0x31, 0x06, 0x41, 0x01, 0x00, 0x80, 0x01, 0x00 },
+     8, XV_DER, 0 },
+   { "DER SET [0] before [31]",
+     { 0x31, 0x07, 0x80, 0x01, 0x00, 0x9F, 0x1F, 0x01, 0x00 },
+     9, XV_DER, 0 },
+   { "DER SET [31] before [0]",
+     { 0x31, 0x07, 0x9F, 0x1F, 0x01, 0x00, 0x80, 0x01, 0x00 },
+     9, XV_DER, RTERR_SEQORDER },
+   { "DER SET OF INTEGER out of order",
+     { 0x31, 0x06, 0x02, 0x01, 0x05, 0x02, 0x01, 0x03 },
+     8, XV_DER, RTERR_SEQORDER },
+   { "DER SET OF INTEGER in order",
+     { 0x31, 0x06, 0x02, 0x01, 0x03, 0x02, 0x01, 0x05 },
+     8, XV_DER, 0 },
+   { "BER SET OF INTEGER out of order",
+     { 0x31, 0x06, 0x02, 0x01, 0x05, 0x02, 0x01, 0x03 },
+     8, 0, 0 },
+   { "DER SET OF OCTET STRING, shorter first",
+     { 0x31, 0x07, 0x04, 0x01, 0x01, 0x04, 0x02, 0x01, 0x00 },
+     9, XV_DER, 0 },
+   { "DER SET OF OCTET STRING, longer first",
+     { 0x31, 0x07, 0x04, 0x02, 0x01, 0x00, 0x04, 0x01, 0x01 },
+     9, XV_DER, RTERR_SEQORDER },
+   { "DER SET OF equal elements",
+     { 0x31, 0x06, 0x02, 0x01, 0x05, 0x02, 0x01, 0x05 },
+     8, XV_DER, 0 },
+   { "DER SET in SEQUENCE, components out of order",
+     { 0x30, 0x08, 0x31, 0x06, 0x81, 0x01, 0x00, 0x80, 0x01, 0x00 },
+     10, XV_DER, RTERR_SEQORDER }
+} ;
+
+int main (int argc, char** argv)
+{
+   OSCTXT ctxt;
+   size_t i;
+   int    stat, failures = 0;
+
+   for (i = 0; i < sizeof(vectors)/sizeof(vectors[0]); i++) {
+      if (rtInitContext (&ctxt) != 0) {
+         printf ("Error initializing context\n");
+         return -1;
+      }
+      rtxInitContextBuffer (&ctxt, (OSOCTET*)vectors[i].data,
+                            vectors[i].size);
+
+      stat = xd_Validate (&ctxt, vectors[i].flags);
+      if (stat != vectors[i].expected) {
+         printf ("%s: status %d, expected %d\n", vectors[i].desc,
+                 stat, vectors[i].expected);
+         failures++;
+      }
+
+      rtFreeContext (&ctxt);
+   }
+
+   printf ("%d of %d xd_Validate tests failed\n", failures, (int)i);
+
+   return (failures == 0) ? 0 : 1;
+}